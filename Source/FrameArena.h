@@ -0,0 +1,103 @@
+///////////////////////////////////////////////////////////////////////////////
+// framearena.h
+// ============
+// bump allocator for transient per-frame data - reset once per frame
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/***********************************************************
+ *  FrameArena
+ *
+ *  This class contains the code for a bump allocator that
+ *  backs transient per-frame data.  Allocations are pointer
+ *  bumps inside fixed-size blocks, nothing is freed
+ *  individually, and Reset() rewinds the whole arena at the
+ *  start of each frame - so steady-state rendering performs
+ *  no heap allocations at all.
+ ***********************************************************/
+class FrameArena
+{
+public:
+	// constructor
+	FrameArena()
+	{
+		m_currentBlock = 0;
+		m_currentOffset = 0;
+	}
+
+	// destructor
+	~FrameArena()
+	{
+		for (int i = 0; i < m_blocks.size(); i++)
+		{
+			delete[] m_blocks[i];
+		}
+	}
+
+	// rewind the arena - every earlier allocation is invalid
+	// after this, the blocks themselves are kept for reuse
+	void Reset()
+	{
+		m_currentBlock = 0;
+		m_currentOffset = 0;
+	}
+
+	// allocate the passed in number of bytes from the arena -
+	// a pointer bump in steady state, a new block is only
+	// created the first time a frame needs more space
+	void* Allocate(size_t bytes)
+	{
+		// round the size up so every allocation stays aligned
+		bytes = (bytes + (ALIGNMENT - 1)) & ~(size_t)(ALIGNMENT - 1);
+
+		// advance past blocks without enough room left
+		while ((m_currentBlock < m_blocks.size()) &&
+			(m_currentOffset + bytes > m_blockSizes[m_currentBlock]))
+		{
+			m_currentBlock++;
+			m_currentOffset = 0;
+		}
+
+		// grow the arena the first time this much space is
+		// needed - oversized requests get a dedicated block
+		if (m_currentBlock >= m_blocks.size())
+		{
+			size_t blockSize = (bytes > BLOCK_SIZE) ? bytes : BLOCK_SIZE;
+
+			m_blocks.push_back(new unsigned char[blockSize]);
+			m_blockSizes.push_back(blockSize);
+			m_currentOffset = 0;
+		}
+
+		void* pAllocation = m_blocks[m_currentBlock] + m_currentOffset;
+		m_currentOffset += bytes;
+
+		return(pAllocation);
+	}
+
+	// typed helper for allocating an array from the arena
+	template <typename T>
+	T* AllocateArray(int count)
+	{
+		return((T*)Allocate(sizeof(T) * count));
+	}
+
+private:
+	// alignment applied to every allocation
+	static const size_t ALIGNMENT = 16;
+	// size of each arena block
+	static const size_t BLOCK_SIZE = 1024 * 1024;
+
+	// the allocated blocks, kept alive across Reset() calls
+	std::vector<unsigned char*> m_blocks;
+	// the usable size of each allocated block
+	std::vector<size_t> m_blockSizes;
+	// index of the block currently being bumped
+	size_t m_currentBlock;
+	// bump offset inside the current block
+	size_t m_currentOffset;
+};
@@ -0,0 +1,182 @@
+///////////////////////////////////////////////////////////////////////////////
+// framecapture.cpp
+// ============
+// encode and write captured frames on a worker thread
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameCapture.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+/***********************************************************
+ *  FrameCapture()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameCapture::FrameCapture()
+{
+	m_width = 0;
+	m_height = 0;
+	m_bStopRequested = false;
+}
+
+/***********************************************************
+ *  ~FrameCapture()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameCapture::~FrameCapture()
+{
+	Stop();
+}
+
+/***********************************************************
+ *  Start()
+ *
+ *  This method is used for starting the capture worker for
+ *  frames of the passed in dimensions.
+ ***********************************************************/
+void FrameCapture::Start(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+	m_bStopRequested = false;
+
+	m_workerThread = std::thread(&FrameCapture::WorkerLoop, this);
+}
+
+/***********************************************************
+ *  Submit()
+ *
+ *  This method is used for queuing one frame of RGBA
+ *  readback pixels for encoding.  The pixels are copied into
+ *  a recycled buffer and the call returns immediately - the
+ *  render thread never waits on the encoder.
+ ***********************************************************/
+void FrameCapture::Submit(int frameNumber, const unsigned char* pPixels)
+{
+	CAPTURE_JOB job;
+	size_t frameBytes = (size_t)m_width * m_height * 4;
+
+	job.frameNumber = frameNumber;
+
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+
+		// reuse a drained pixel buffer when one is available
+		if (m_freeBuffers.size() > 0)
+		{
+			job.pixels.swap(m_freeBuffers.back());
+			m_freeBuffers.pop_back();
+		}
+	}
+
+	job.pixels.resize(frameBytes);
+	memcpy(job.pixels.data(), pPixels, frameBytes);
+
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_pendingJobs.push(std::move(job));
+	}
+	m_queueCondition.notify_one();
+}
+
+/***********************************************************
+ *  Stop()
+ *
+ *  This method is used for draining the queued frames and
+ *  stopping the worker thread.
+ ***********************************************************/
+void FrameCapture::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_queueMutex);
+		m_bStopRequested = true;
+	}
+	m_queueCondition.notify_one();
+
+	if (m_workerThread.joinable())
+	{
+		m_workerThread.join();
+	}
+}
+
+/***********************************************************
+ *  WorkerLoop()
+ *
+ *  This method is the capture worker thread - it encodes
+ *  and writes queued frames until a stop is requested and
+ *  the queue has drained.
+ ***********************************************************/
+void FrameCapture::WorkerLoop()
+{
+	char filename[64];
+
+	while (true)
+	{
+		CAPTURE_JOB job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_queueMutex);
+
+			m_queueCondition.wait(lock, [this]
+			{
+				return((m_pendingJobs.size() > 0) || m_bStopRequested);
+			});
+
+			if ((0 == m_pendingJobs.size()) && m_bStopRequested)
+			{
+				return;
+			}
+
+			job = std::move(m_pendingJobs.front());
+			m_pendingJobs.pop();
+		}
+
+		snprintf(filename, sizeof(filename), "frame_%06d.ppm", job.frameNumber);
+		WriteFramePPM(filename, job.pixels.data());
+
+		// recycle the pixel buffer for a later frame
+		{
+			std::lock_guard<std::mutex> lock(m_queueMutex);
+			m_freeBuffers.push_back(std::move(job.pixels));
+		}
+	}
+}
+
+/***********************************************************
+ *  WriteFramePPM()
+ *
+ *  This method is used for writing one read-back RGBA frame
+ *  to disk as a binary PPM image, flipping the rows so the
+ *  image is top-down.
+ ***********************************************************/
+bool FrameCapture::WriteFramePPM(const char* filename, const unsigned char* pPixels)
+{
+	FILE* pFile = fopen(filename, "wb");
+	if (NULL == pFile)
+	{
+		std::cerr << "Failed to write frame file " << filename << std::endl;
+		return(false);
+	}
+
+	fprintf(pFile, "P6\n%d %d\n255\n", m_width, m_height);
+
+	// OpenGL reads rows bottom-up - write them top-down and
+	// drop the alpha channel
+	for (int row = m_height - 1; row >= 0; row--)
+	{
+		const unsigned char* pRow = pPixels + (row * m_width * 4);
+
+		for (int column = 0; column < m_width; column++)
+		{
+			fwrite(pRow + (column * 4), 1, 3, pFile);
+		}
+	}
+
+	fclose(pFile);
+
+	return(true);
+}
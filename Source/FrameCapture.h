@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+// framecapture.h
+// ============
+// encode and write captured frames on a worker thread
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/***********************************************************
+ *  FrameCapture
+ *
+ *  This class contains the code for writing captured frames
+ *  to disk off the render thread.  The render thread hands
+ *  over the mapped readback pixels with one memcpy into a
+ *  pooled buffer and returns immediately - the encoding and
+ *  file writes all happen on the capture worker thread, so
+ *  sustained capture costs the frame loop only that copy.
+ ***********************************************************/
+class FrameCapture
+{
+public:
+	// constructor
+	FrameCapture();
+	// destructor
+	~FrameCapture();
+
+	// start the capture worker for frames of the passed in
+	// dimensions
+	void Start(int width, int height);
+	// queue one frame of RGBA readback pixels for encoding -
+	// copies into a pooled buffer and returns immediately
+	void Submit(int frameNumber, const unsigned char* pPixels);
+	// drain the queued frames and stop the worker thread
+	void Stop();
+
+private:
+	// one queued frame waiting for the worker thread
+	struct CAPTURE_JOB
+	{
+		int frameNumber;
+		std::vector<unsigned char> pixels;
+	};
+
+	// dimensions of the captured frames
+	int m_width;
+	int m_height;
+	// the capture worker thread and its shutdown flag
+	std::thread m_workerThread;
+	bool m_bStopRequested;
+	// queued frames and the recycled pixel buffers - pooling
+	// keeps steady-state capture free of heap allocations
+	std::queue<CAPTURE_JOB> m_pendingJobs;
+	std::vector<std::vector<unsigned char>> m_freeBuffers;
+	std::mutex m_queueMutex;
+	std::condition_variable m_queueCondition;
+
+	// the worker loop - encodes and writes queued frames
+	void WorkerLoop();
+
+	// write one RGBA frame to disk as a binary PPM image
+	bool WriteFramePPM(const char* filename, const unsigned char* pPixels);
+};
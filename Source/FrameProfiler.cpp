@@ -0,0 +1,307 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.cpp
+// ============
+// measure the per-stage CPU and GPU timing of the rendered frames
+///////////////////////////////////////////////////////////////////////////////
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// number of frames between the rolled-up console summaries
+	const int SUMMARY_INTERVAL = 240;
+
+	// the human readable names for the timed frame stages
+	const char* g_StageNames[FrameProfiler::STAGE_COUNT] =
+	{
+		"view",
+		"render",
+		"swap"
+	};
+}
+
+/***********************************************************
+ *  FrameProfiler()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+FrameProfiler::FrameProfiler()
+{
+	m_nextSampleIndex = 0;
+	m_frameCount = 0;
+	m_frameStartSeconds = 0.0;
+	m_nextGPUQueryIndex = 0;
+	m_lastGPUMilliseconds = 0.0;
+
+	for (int i = 0; i < STAGE_COUNT; i++)
+	{
+		m_stageStartSeconds[i] = 0.0;
+		m_currentSample.stageMilliseconds[i] = 0.0;
+	}
+	m_currentSample.frameMilliseconds = 0.0;
+	m_currentSample.gpuMilliseconds = 0.0;
+
+	// create the round-robin GPU timer query objects
+	glGenQueries(GPU_QUERY_COUNT, m_gpuQueries);
+	for (int i = 0; i < GPU_QUERY_COUNT; i++)
+	{
+		m_gpuQueryIssued[i] = false;
+	}
+}
+
+/***********************************************************
+ *  ~FrameProfiler()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+FrameProfiler::~FrameProfiler()
+{
+	glDeleteQueries(GPU_QUERY_COUNT, m_gpuQueries);
+}
+
+/***********************************************************
+ *  GetTimeSeconds()
+ *
+ *  This method is used for getting the current CPU time
+ *  in seconds from a monotonic clock.
+ ***********************************************************/
+double FrameProfiler::GetTimeSeconds() const
+{
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+
+	return(std::chrono::duration<double>(now.time_since_epoch()).count());
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for marking the start of a new frame.
+ ***********************************************************/
+void FrameProfiler::BeginFrame()
+{
+	m_frameStartSeconds = GetTimeSeconds();
+
+	for (int i = 0; i < STAGE_COUNT; i++)
+	{
+		m_currentSample.stageMilliseconds[i] = 0.0;
+	}
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for marking the end of the current
+ *  frame and rolling the completed sample into the window.
+ ***********************************************************/
+void FrameProfiler::EndFrame()
+{
+	m_currentSample.frameMilliseconds = (GetTimeSeconds() - m_frameStartSeconds) * 1000.0;
+
+	// pick up any GPU timer results that have become available
+	PollGPUQueries();
+	m_currentSample.gpuMilliseconds = m_lastGPUMilliseconds;
+
+	// roll the completed sample into the window
+	if (m_samples.size() < SAMPLE_WINDOW)
+	{
+		m_samples.push_back(m_currentSample);
+	}
+	else
+	{
+		m_samples[m_nextSampleIndex] = m_currentSample;
+		m_nextSampleIndex = (m_nextSampleIndex + 1) % SAMPLE_WINDOW;
+	}
+
+	m_frameCount++;
+
+	// print the rolled-up summary periodically - the console
+	// stands in for an on-screen overlay
+	if ((m_frameCount % SUMMARY_INTERVAL) == 0)
+	{
+		PrintSummary();
+	}
+}
+
+/***********************************************************
+ *  BeginStage()
+ *
+ *  This method is used for marking the start of a timed
+ *  frame stage.
+ ***********************************************************/
+void FrameProfiler::BeginStage(FRAME_STAGE stage)
+{
+	m_stageStartSeconds[stage] = GetTimeSeconds();
+}
+
+/***********************************************************
+ *  EndStage()
+ *
+ *  This method is used for marking the end of a timed
+ *  frame stage.
+ ***********************************************************/
+void FrameProfiler::EndStage(FRAME_STAGE stage)
+{
+	m_currentSample.stageMilliseconds[stage] +=
+		(GetTimeSeconds() - m_stageStartSeconds[stage]) * 1000.0;
+}
+
+/***********************************************************
+ *  BeginGPUTimer()
+ *
+ *  This method is used for starting the GPU timer query
+ *  around the draw submission.
+ ***********************************************************/
+void FrameProfiler::BeginGPUTimer()
+{
+	// skip the frame when the next query in the ring is still
+	// in flight - never stall waiting for the GPU
+	if (false == m_gpuQueryIssued[m_nextGPUQueryIndex])
+	{
+		glBeginQuery(GL_TIME_ELAPSED, m_gpuQueries[m_nextGPUQueryIndex]);
+	}
+}
+
+/***********************************************************
+ *  EndGPUTimer()
+ *
+ *  This method is used for ending the GPU timer query
+ *  around the draw submission.
+ ***********************************************************/
+void FrameProfiler::EndGPUTimer()
+{
+	if (false == m_gpuQueryIssued[m_nextGPUQueryIndex])
+	{
+		glEndQuery(GL_TIME_ELAPSED);
+		m_gpuQueryIssued[m_nextGPUQueryIndex] = true;
+		m_nextGPUQueryIndex = (m_nextGPUQueryIndex + 1) % GPU_QUERY_COUNT;
+	}
+}
+
+/***********************************************************
+ *  PollGPUQueries()
+ *
+ *  This method is used for collecting any completed GPU
+ *  timer query results without stalling the pipeline.
+ ***********************************************************/
+void FrameProfiler::PollGPUQueries()
+{
+	for (int i = 0; i < GPU_QUERY_COUNT; i++)
+	{
+		if (true == m_gpuQueryIssued[i])
+		{
+			GLint available = 0;
+
+			glGetQueryObjectiv(m_gpuQueries[i], GL_QUERY_RESULT_AVAILABLE, &available);
+			if (available)
+			{
+				GLuint64 elapsedNanoseconds = 0;
+
+				glGetQueryObjectui64v(m_gpuQueries[i], GL_QUERY_RESULT, &elapsedNanoseconds);
+				m_lastGPUMilliseconds = (double)elapsedNanoseconds / 1000000.0;
+				m_gpuQueryIssued[i] = false;
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  GetSortedPercentile()
+ *
+ *  This method is used for getting a percentile from an
+ *  already sorted list of values.
+ ***********************************************************/
+double FrameProfiler::GetSortedPercentile(
+	const std::vector<double>& sortedValues,
+	double percentile) const
+{
+	if (sortedValues.size() == 0)
+	{
+		return(0.0);
+	}
+
+	int index = (int)(percentile * (double)(sortedValues.size() - 1));
+
+	return(sortedValues[index]);
+}
+
+/***********************************************************
+ *  GetFrameTimePercentile()
+ *
+ *  This method is used for getting a percentile of the
+ *  rolled-up frame times in milliseconds.
+ ***********************************************************/
+double FrameProfiler::GetFrameTimePercentile(double percentile) const
+{
+	std::vector<double> frameTimes;
+
+	for (int i = 0; i < m_samples.size(); i++)
+	{
+		frameTimes.push_back(m_samples[i].frameMilliseconds);
+	}
+	std::sort(frameTimes.begin(), frameTimes.end());
+
+	return(GetSortedPercentile(frameTimes, percentile));
+}
+
+/***********************************************************
+ *  PrintSummary()
+ *
+ *  This method is used for printing a rolled-up timing
+ *  summary to the console.
+ ***********************************************************/
+void FrameProfiler::PrintSummary() const
+{
+	std::cout << "INFO: frame timing over last " << m_samples.size() << " frames"
+		<< " - p50:" << GetFrameTimePercentile(0.50) << "ms"
+		<< " p95:" << GetFrameTimePercentile(0.95) << "ms"
+		<< " p99:" << GetFrameTimePercentile(0.99) << "ms"
+		<< " gpu:" << m_lastGPUMilliseconds << "ms" << std::endl;
+}
+
+/***********************************************************
+ *  WriteReport()
+ *
+ *  This method is used for writing all aggregated timing
+ *  values into a CSV file for the telemetry pipeline.
+ ***********************************************************/
+bool FrameProfiler::WriteReport(const char* filename) const
+{
+	FILE* pFile = fopen(filename, "w");
+	if (NULL == pFile)
+	{
+		std::cout << "Could not write timing report:" << filename << std::endl;
+		return false;
+	}
+
+	// one header row, then one row per retained frame sample
+	fprintf(pFile, "frame_ms,gpu_ms");
+	for (int i = 0; i < STAGE_COUNT; i++)
+	{
+		fprintf(pFile, ",%s_ms", g_StageNames[i]);
+	}
+	fprintf(pFile, "\n");
+
+	for (int i = 0; i < m_samples.size(); i++)
+	{
+		fprintf(pFile, "%.4f,%.4f",
+			m_samples[i].frameMilliseconds,
+			m_samples[i].gpuMilliseconds);
+		for (int j = 0; j < STAGE_COUNT; j++)
+		{
+			fprintf(pFile, ",%.4f", m_samples[i].stageMilliseconds[j]);
+		}
+		fprintf(pFile, "\n");
+	}
+
+	fclose(pFile);
+
+	std::cout << "INFO: wrote timing report:" << filename << std::endl;
+
+	return true;
+}
@@ -0,0 +1,112 @@
+///////////////////////////////////////////////////////////////////////////////
+// frameprofiler.h
+// ============
+// measure the per-stage CPU and GPU timing of the rendered frames
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  FrameProfiler
+ *
+ *  This class contains the code for timing the stages of
+ *  each rendered frame on the CPU, timing the draw
+ *  submission on the GPU, and aggregating the samples into
+ *  rolling percentiles for reporting.
+ ***********************************************************/
+class FrameProfiler
+{
+public:
+	// constructor
+	FrameProfiler();
+	// destructor
+	~FrameProfiler();
+
+	// the stages of a frame that are timed individually
+	enum FRAME_STAGE
+	{
+		STAGE_VIEW,
+		STAGE_RENDER,
+		STAGE_SWAP,
+		STAGE_COUNT
+	};
+
+	// mark the start of a new frame
+	void BeginFrame();
+	// mark the end of the current frame
+	void EndFrame();
+
+	// mark the start and end of a timed frame stage
+	void BeginStage(FRAME_STAGE stage);
+	void EndStage(FRAME_STAGE stage);
+
+	// mark the start and end of the GPU timer query around
+	// the draw submission
+	void BeginGPUTimer();
+	void EndGPUTimer();
+
+	// get a percentile (0.0 - 1.0) of the rolled-up frame
+	// times in milliseconds
+	double GetFrameTimePercentile(double percentile) const;
+
+	// write all aggregated timing values into a CSV file
+	bool WriteReport(const char* filename) const;
+
+private:
+	// one complete set of timing samples for a frame
+	struct FRAME_SAMPLE
+	{
+		double stageMilliseconds[STAGE_COUNT];
+		double frameMilliseconds;
+		double gpuMilliseconds;
+	};
+
+	// number of retained frame samples for the rolling window
+	static const int SAMPLE_WINDOW = 512;
+
+	// number of GPU timer queries kept in flight so results
+	// are read back without stalling the pipeline
+	static const int GPU_QUERY_COUNT = 4;
+
+	// rolling window of completed frame samples
+	std::vector<FRAME_SAMPLE> m_samples;
+	// the sample currently being filled in
+	FRAME_SAMPLE m_currentSample;
+	// index of the next rolling window entry to overwrite
+	int m_nextSampleIndex;
+	// total number of completed frames
+	long m_frameCount;
+
+	// per-stage CPU start times for the current frame
+	double m_stageStartSeconds[STAGE_COUNT];
+	// CPU start time of the current frame
+	double m_frameStartSeconds;
+
+	// GPU timer query objects used round-robin
+	GLuint m_gpuQueries[GPU_QUERY_COUNT];
+	// true once the matching query has been issued
+	bool m_gpuQueryIssued[GPU_QUERY_COUNT];
+	// index of the next GPU query to issue
+	int m_nextGPUQueryIndex;
+	// most recent retrieved GPU time in milliseconds
+	double m_lastGPUMilliseconds;
+
+	// get the current CPU time in seconds
+	double GetTimeSeconds() const;
+
+	// collect any completed GPU timer query results
+	void PollGPUQueries();
+
+	// print a rolled-up summary to the console
+	void PrintSummary() const;
+
+	// get a percentile from an already sorted list of values
+	double GetSortedPercentile(
+		const std::vector<double>& sortedValues,
+		double percentile) const;
+};
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuresourcetracker.cpp
+// ============
+// account for the GPU memory held by each resource category
+///////////////////////////////////////////////////////////////////////////////
+
+#include "GpuResourceTracker.h"
+
+#include <iostream>
+
+// declaration of global variables
+namespace
+{
+	// the human readable names for the resource categories
+	const char* g_CategoryNames[GpuResourceTracker::CATEGORY_COUNT] =
+	{
+		"textures",
+		"vertex data",
+		"instance buffers"
+	};
+}
+
+std::atomic<long long> GpuResourceTracker::s_categoryBytes[CATEGORY_COUNT];
+
+/***********************************************************
+ *  Add()
+ *
+ *  This method is used for recording bytes of GPU memory
+ *  taken by a resource category.
+ ***********************************************************/
+void GpuResourceTracker::Add(RESOURCE_CATEGORY category, size_t bytes)
+{
+	s_categoryBytes[category] += (long long)bytes;
+}
+
+/***********************************************************
+ *  Remove()
+ *
+ *  This method is used for recording bytes of GPU memory
+ *  released by a resource category.
+ ***********************************************************/
+void GpuResourceTracker::Remove(RESOURCE_CATEGORY category, size_t bytes)
+{
+	s_categoryBytes[category] -= (long long)bytes;
+}
+
+/***********************************************************
+ *  GetBytes()
+ *
+ *  This method is used for getting the bytes currently held
+ *  by a resource category.
+ ***********************************************************/
+size_t GpuResourceTracker::GetBytes(RESOURCE_CATEGORY category)
+{
+	long long bytes = s_categoryBytes[category];
+
+	return((bytes > 0) ? (size_t)bytes : 0);
+}
+
+/***********************************************************
+ *  GetTotalBytes()
+ *
+ *  This method is used for getting the bytes currently held
+ *  across all resource categories.
+ ***********************************************************/
+size_t GpuResourceTracker::GetTotalBytes()
+{
+	size_t totalBytes = 0;
+
+	for (int i = 0; i < CATEGORY_COUNT; i++)
+	{
+		totalBytes += GetBytes((RESOURCE_CATEGORY)i);
+	}
+
+	return(totalBytes);
+}
+
+/***********************************************************
+ *  PrintReport()
+ *
+ *  This method is used for printing the per-category byte
+ *  counts to the console.
+ ***********************************************************/
+void GpuResourceTracker::PrintReport()
+{
+	std::cout << "INFO: GPU memory held - total:" << GetTotalBytes() << " bytes";
+	for (int i = 0; i < CATEGORY_COUNT; i++)
+	{
+		std::cout << " " << g_CategoryNames[i] << ":" << GetBytes((RESOURCE_CATEGORY)i);
+	}
+	std::cout << std::endl;
+}
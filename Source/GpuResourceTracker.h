@@ -0,0 +1,52 @@
+///////////////////////////////////////////////////////////////////////////////
+// gpuresourcetracker.h
+// ============
+// account for the GPU memory held by each resource category
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/***********************************************************
+ *  GpuResourceTracker
+ *
+ *  This class contains the code for accounting the bytes of
+ *  GPU memory held by each resource category.  Creation and
+ *  deletion paths report their sizes here, so co-located
+ *  renderer instances can see and bound what they hold
+ *  instead of discovering it through driver-level thrashing.
+ ***********************************************************/
+class GpuResourceTracker
+{
+public:
+	// the accounted resource categories - vertex data is
+	// reported by the mesh loaders when they are built with
+	// this tracker available
+	enum RESOURCE_CATEGORY
+	{
+		CATEGORY_TEXTURE,
+		CATEGORY_VERTEX_DATA,
+		CATEGORY_INSTANCE_BUFFER,
+		CATEGORY_COUNT
+	};
+
+	// record bytes of GPU memory taken by a category
+	static void Add(RESOURCE_CATEGORY category, size_t bytes);
+	// record bytes of GPU memory released by a category
+	static void Remove(RESOURCE_CATEGORY category, size_t bytes);
+
+	// get the bytes currently held by a category
+	static size_t GetBytes(RESOURCE_CATEGORY category);
+	// get the bytes currently held across all categories
+	static size_t GetTotalBytes();
+
+	// print the per-category byte counts to the console
+	static void PrintReport();
+
+private:
+	// bytes currently held per category - atomic so loader
+	// threads can report without locking
+	static std::atomic<long long> s_categoryBytes[CATEGORY_COUNT];
+};
@@ -1,186 +1,796 @@
-///////////////////////////////////////////////////////////////////////////////
-// maincode.cpp
-// ============
-// gets called when application is launched - initializes GLEW, GLFW
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include <iostream>         // error handling and output
-#include <cstdlib>          // EXIT_FAILURE
-
-#include <GL/glew.h>        // GLEW library
-#include "GLFW/glfw3.h"     // GLFW library
-
-// GLM Math Header inclusions
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>
-
-#include "SceneManager.h"
-#include "ViewManager.h"
-#include "ShapeMeshes.h"
-#include "ShaderManager.h"
-
-// Namespace for declaring global variables
-namespace
-{
-	// Macro for window title
-	const char* const WINDOW_TITLE = "7-1 FinalProject and Milestones"; 
-
-	// Main GLFW window
-	GLFWwindow* g_Window = nullptr;
-
-	// scene manager object for managing the 3D scene prepare and render
-	SceneManager* g_SceneManager = nullptr;
-	// shader manager object for dynamic interaction with the shader code
-	ShaderManager* g_ShaderManager = nullptr;
-	// view manager object for managing the 3D view setup and projection to 2D
-	ViewManager* g_ViewManager = nullptr;
-}
-
-// Function declarations - all functions that are called manually
-// need to be pre-declared at the beginning of the source code.
-bool InitializeGLFW();
-bool InitializeGLEW();
-
-
-/***********************************************************
- *  main(int, char*)
- *
- *  This function gets called after the application has been
- *  launched.
- ***********************************************************/
-int main(int argc, char* argv[])
-{
-	// if GLFW fails initialization, then terminate the application
-	if (InitializeGLFW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// try to create a new shader manager object
-	g_ShaderManager = new ShaderManager();
-	// try to create a new view manager object
-	g_ViewManager = new ViewManager(
-		g_ShaderManager);
-
-	// try to create the main display window
-	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
-
-	// if GLEW fails initialization, then terminate the application
-	if (InitializeGLEW() == false)
-	{
-		return(EXIT_FAILURE);
-	}
-
-	// load the shader code from the external GLSL files
-	g_ShaderManager->LoadShaders(
-		"shaders/vertexShader.glsl",
-		"shaders/fragmentShader.glsl");
-	g_ShaderManager->use();
-
-	// try to create a new scene manager object and prepare the 3D scene
-	g_SceneManager = new SceneManager(g_ShaderManager);
-	g_SceneManager->PrepareScene();
-
-	// loop will keep running until the application is closed 
-	// or until an error has occurred
-	while (!glfwWindowShouldClose(g_Window))
-	{
-		// Enable z-depth
-		glEnable(GL_DEPTH_TEST);
-
-		// Clear the frame and z buffers
-		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// convert from 3D object space to 2D view
-		g_ViewManager->PrepareSceneView();
-
-		// refresh the 3D scene
-		g_SceneManager->RenderScene();
-
-
-		// Flips the the back buffer with the front buffer every frame.
-		glfwSwapBuffers(g_Window);
-
-		// query the latest GLFW events
-		glfwPollEvents();
-	}
-
-	// clear the allocated manager objects from memory
-	if (NULL != g_SceneManager)
-	{
-		delete g_SceneManager;
-		g_SceneManager = NULL;
-	}
-	if (NULL != g_ViewManager)
-	{
-		delete g_ViewManager;
-		g_ViewManager = NULL;
-	}
-	if (NULL != g_ShaderManager)
-	{
-		delete g_ShaderManager;
-		g_ShaderManager = NULL;
-	}
-
-	// Terminates the program successfully
-	exit(EXIT_SUCCESS); 
-}
-
-/***********************************************************
- *	InitializeGLFW()
- * 
- *  This function is used to initialize the GLFW library.   
- ***********************************************************/
-bool InitializeGLFW()
-{
-	// GLFW: initialize and configure library
-	// --------------------------------------
-	glfwInit();
-
-#ifdef __APPLE__
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
-	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
-#else
-	// set the version of OpenGL and profile to use
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-#endif
-	// GLFW: end -------------------------------
-
-	return(true);
-}
-
-/***********************************************************
- *	InitializeGLEW()
- *
- *  This function is used to initialize the GLEW library.
- ***********************************************************/
-bool InitializeGLEW()
-{
-	// GLEW: initialize
-	// -----------------------------------------
-	GLenum GLEWInitResult = GLEW_OK;
-
-	// try to initialize the GLEW library
-	GLEWInitResult = glewInit();
-	if (GLEW_OK != GLEWInitResult)
-	{
-		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
-		return false;
-	}
-	// GLEW: end -------------------------------
-
-	// Displays a successful OpenGL initialization message
-	std::cout << "INFO: OpenGL Successfully Initialized\n";
-	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
-
-	return(true);
-}
\ No newline at end of file
+///////////////////////////////////////////////////////////////////////////////
+// maincode.cpp
+// ============
+// gets called when application is launched - initializes GLEW, GLFW
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include <iostream>         // error handling and output
+#include <atomic>           // benchmark allocation counter
+#include <cstdlib>          // EXIT_FAILURE
+#include <cstdio>           // batch frame file output
+#include <cstring>          // command line parsing
+#include <cmath>            // comparison view camera placement
+#include <new>              // benchmark allocation counter
+#include <thread>           // startup worker threads
+#include <vector>           // startup worker threads
+
+#include <GL/glew.h>        // GLEW library
+#include "GLFW/glfw3.h"     // GLFW library
+
+// GLM Math Header inclusions
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "SceneManager.h"
+#include "ViewManager.h"
+#include "ShapeMeshes.h"
+#include "ShaderManager.h"
+#include "FrameProfiler.h"
+#include "ProgramBinaryCache.h"
+#include "FrameCapture.h"
+#include "SceneLoader.h"
+#include "GpuResourceTracker.h"
+
+// Namespace for declaring global variables
+namespace
+{
+	// Macro for window title
+	const char* const WINDOW_TITLE = "7-1 FinalProject and Milestones"; 
+
+	// Main GLFW window
+	GLFWwindow* g_Window = nullptr;
+
+	// scene manager object for managing the 3D scene prepare and render
+	SceneManager* g_SceneManager = nullptr;
+	// shader manager object for dynamic interaction with the shader code
+	ShaderManager* g_ShaderManager = nullptr;
+	// view manager object for managing the 3D view setup and projection to 2D
+	ViewManager* g_ViewManager = nullptr;
+	// frame profiler object for per-stage CPU/GPU frame timing
+	FrameProfiler* g_FrameProfiler = nullptr;
+	// frame capture object encoding captured frames off the
+	// render thread
+	FrameCapture* g_FrameCapture = nullptr;
+
+	// the file that the aggregated frame timing is written into on exit
+	const char* const TIMING_REPORT_FILENAME = "frame_timing.csv";
+
+	// true when rendering headless into an offscreen framebuffer
+	bool g_bHeadlessMode = false;
+	// number of frames to render in headless batch mode
+	int g_BatchFrameCount = 0;
+	// number of pixel buffer objects in the readback ring
+	const int READBACK_RING_SIZE = 3;
+
+	// true when the headless run writes its frames to disk
+	bool g_bCaptureMode = false;
+
+	// number of comparison views to render each frame
+	int g_ViewCount = 1;
+
+	// optional soft texture memory budget in megabytes - zero
+	// leaves eviction disabled
+	int g_TextureBudgetMB = 0;
+
+	// true when running the synthetic benchmark workload
+	bool g_bBenchmarkMode = false;
+	// workload scaling for the synthetic benchmark scene
+	int g_BenchmarkObjectCount = 0;
+	int g_BenchmarkMaterialCount = 8;
+	int g_BenchmarkTextureCount = 2;
+	// number of frames a benchmark run renders by default
+	const int BENCHMARK_DEFAULT_FRAMES = 300;
+	// the files the benchmark results are written to and the
+	// saved baseline they are compared against
+	const char* const BENCHMARK_RESULTS_FILENAME = "benchmark_results.csv";
+	const char* const BENCHMARK_BASELINE_FILENAME = "benchmark_baseline.csv";
+	// heap allocations counted over the whole run and the
+	// count sampled when the steady-state window began
+	std::atomic<long> g_AllocationCount(0);
+	long g_SteadyAllocationStart = 0;
+	int g_SteadyFrameCount = 0;
+}
+
+// global allocation hooks - every heap allocation bumps the
+// counter so the benchmark can verify the zero-allocation
+// steady-state claim of the retained render path
+void* operator new(size_t size)
+{
+	void* pAllocation = malloc(size);
+
+	if (NULL == pAllocation)
+	{
+		throw std::bad_alloc();
+	}
+	g_AllocationCount++;
+
+	return(pAllocation);
+}
+
+void* operator new[](size_t size)
+{
+	return(operator new(size));
+}
+
+void operator delete(void* pAllocation) noexcept
+{
+	free(pAllocation);
+}
+
+void operator delete(void* pAllocation, size_t size) noexcept
+{
+	free(pAllocation);
+}
+
+void operator delete[](void* pAllocation) noexcept
+{
+	free(pAllocation);
+}
+
+void operator delete[](void* pAllocation, size_t size) noexcept
+{
+	free(pAllocation);
+}
+
+// Function declarations - all functions that are called manually
+// need to be pre-declared at the beginning of the source code.
+bool InitializeGLFW();
+bool InitializeGLEW();
+int RunBatchRender(int frameCount);
+bool WriteBenchmarkResults(const char* filename);
+void CompareBenchmarkBaseline(const char* baselineFilename);
+
+
+/***********************************************************
+ *  main(int, char*)
+ *
+ *  This function gets called after the application has been
+ *  launched.
+ ***********************************************************/
+int main(int argc, char* argv[])
+{
+	// parse the command line - batch rendering on the farm runs
+	// headless with a fixed frame count
+	for (int i = 1; i < argc; i++)
+	{
+		if (strcmp(argv[i], "--headless") == 0)
+		{
+			g_bHeadlessMode = true;
+		}
+		else if ((strcmp(argv[i], "--frames") == 0) && (i + 1 < argc))
+		{
+			g_BatchFrameCount = atoi(argv[i + 1]);
+			g_bHeadlessMode = true;
+			i++;
+		}
+		else if ((strcmp(argv[i], "--views") == 0) && (i + 1 < argc))
+		{
+			g_ViewCount = atoi(argv[i + 1]);
+			if (g_ViewCount < 1)
+			{
+				g_ViewCount = 1;
+			}
+			if (g_ViewCount > 4)
+			{
+				g_ViewCount = 4;
+			}
+			i++;
+		}
+		else if (strcmp(argv[i], "--capture") == 0)
+		{
+			g_bCaptureMode = true;
+			g_bHeadlessMode = true;
+		}
+		else if ((strcmp(argv[i], "--benchmark") == 0) && (i + 1 < argc))
+		{
+			g_BenchmarkObjectCount = atoi(argv[i + 1]);
+			g_bBenchmarkMode = true;
+			g_bHeadlessMode = true;
+			i++;
+		}
+		else if ((strcmp(argv[i], "--materials") == 0) && (i + 1 < argc))
+		{
+			g_BenchmarkMaterialCount = atoi(argv[i + 1]);
+			if (g_BenchmarkMaterialCount < 1)
+			{
+				g_BenchmarkMaterialCount = 1;
+			}
+			i++;
+		}
+		else if ((strcmp(argv[i], "--textures") == 0) && (i + 1 < argc))
+		{
+			g_BenchmarkTextureCount = atoi(argv[i + 1]);
+			if (g_BenchmarkTextureCount < 0)
+			{
+				g_BenchmarkTextureCount = 0;
+			}
+			i++;
+		}
+		else if ((strcmp(argv[i], "--texture-budget") == 0) && (i + 1 < argc))
+		{
+			g_TextureBudgetMB = atoi(argv[i + 1]);
+			if (g_TextureBudgetMB < 0)
+			{
+				g_TextureBudgetMB = 0;
+			}
+			i++;
+		}
+	}
+
+	// a benchmark run renders a fixed frame count so the
+	// distributions are comparable between runs
+	if ((true == g_bBenchmarkMode) && (g_BatchFrameCount <= 0))
+	{
+		g_BatchFrameCount = BENCHMARK_DEFAULT_FRAMES;
+	}
+
+	// kick the CPU-only startup work onto worker threads
+	// before any GL exists - the scene parse and the texture
+	// decodes overlap window creation, GLEW initialization
+	// and shader compilation
+	std::vector<std::thread> startupThreads;
+	startupThreads.push_back(std::thread(
+		SceneLoader::PreloadSceneRecords, "scenes/charcuterie.scene"));
+	startupThreads.push_back(std::thread(
+		SceneManager::PrefetchTextureImage, "textures/tableWood.jpg"));
+	startupThreads.push_back(std::thread(
+		SceneManager::PrefetchTextureImage, "textures/glassTop.jpg"));
+	startupThreads.push_back(std::thread(
+		SceneManager::PrefetchTextureImage, "textures/glassBottom.jpg"));
+
+	// if GLFW fails initialization, then terminate the application
+	if (InitializeGLFW() == false)
+	{
+		// collect the startup workers before exiting - a
+		// joinable thread destroyed with the vector would
+		// terminate the process instead of exiting cleanly
+		for (int i = 0; i < startupThreads.size(); i++)
+		{
+			startupThreads[i].join();
+		}
+		return(EXIT_FAILURE);
+	}
+
+	// try to create a new shader manager object
+	g_ShaderManager = new ShaderManager();
+	// try to create a new view manager object
+	g_ViewManager = new ViewManager(
+		g_ShaderManager);
+
+	// register the fixed comparison cameras - the one shared
+	// scene renders once per view, so textures and meshes are
+	// paid for once no matter how many angles are shown
+	if (g_ViewCount > 1)
+	{
+		for (int view = 0; view < g_ViewCount; view++)
+		{
+			float angleRadians = glm::radians(90.0f * (float)view);
+
+			g_ViewManager->AddViewCamera(
+				glm::vec3(12.0f * cosf(angleRadians), 6.0f, 12.0f * sinf(angleRadians)),
+				glm::vec3(0.0f, 1.0f, 0.0f));
+		}
+	}
+
+	// try to create the main display window
+	g_Window = g_ViewManager->CreateDisplayWindow(WINDOW_TITLE);
+
+	// if GLEW fails initialization, then terminate the application
+	if (InitializeGLEW() == false)
+	{
+		// collect the startup workers before exiting
+		for (int i = 0; i < startupThreads.size(); i++)
+		{
+			startupThreads[i].join();
+		}
+		return(EXIT_FAILURE);
+	}
+
+	// load the shader code from the external GLSL files
+	g_ShaderManager->LoadShaders(
+		"shaders/vertexShader.glsl",
+		"shaders/fragmentShader.glsl");
+	g_ShaderManager->use();
+
+	// save the compiled program binary keyed by the shader
+	// sources and driver, so a loader can skip compilation on
+	// later launches
+	ProgramBinaryCache::SaveCurrentProgram(
+		"shaders/vertexShader.glsl",
+		"shaders/fragmentShader.glsl");
+
+	// collect the startup workers - by now the GL-side setup
+	// has been running in parallel with their CPU work, so
+	// these joins are usually free
+	for (int i = 0; i < startupThreads.size(); i++)
+	{
+		startupThreads[i].join();
+	}
+
+	// try to create a new scene manager object and prepare the 3D scene
+	g_SceneManager = new SceneManager(g_ShaderManager);
+	if (g_TextureBudgetMB > 0)
+	{
+		g_SceneManager->SetTextureBudgetBytes(
+			(size_t)g_TextureBudgetMB * 1024 * 1024);
+	}
+	if (true == g_bBenchmarkMode)
+	{
+		// the benchmark replaces the authored scene with the
+		// synthetic workload at the requested scale
+		g_SceneManager->PrepareBenchmarkScene(
+			g_BenchmarkObjectCount,
+			g_BenchmarkMaterialCount,
+			g_BenchmarkTextureCount);
+	}
+	else
+	{
+		g_SceneManager->PrepareScene();
+	}
+
+	// try to create a new frame profiler object - needs the
+	// OpenGL context for its GPU timer queries
+	g_FrameProfiler = new FrameProfiler();
+
+	// warm-up frame - drawing the scene once and waiting for
+	// the GPU forces the driver's lazy pipeline builds before
+	// the first measured frame
+	glEnable(GL_DEPTH_TEST);
+	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+	g_ViewManager->PrepareSceneView();
+	g_SceneManager->SetFrameCamera(
+		g_ViewManager->GetViewMatrix(),
+		g_ViewManager->GetProjectionMatrix(),
+		g_ViewManager->GetCameraPosition());
+	g_SceneManager->RenderScene();
+	glFinish();
+
+	if (true == g_bHeadlessMode)
+	{
+		// render the requested frames into an offscreen
+		// framebuffer instead of running the interactive loop
+		if (RunBatchRender(g_BatchFrameCount) != EXIT_SUCCESS)
+		{
+			return(EXIT_FAILURE);
+		}
+	}
+	else
+	// loop will keep running until the application is closed 
+	// or until an error has occurred
+	while (!glfwWindowShouldClose(g_Window))
+	{
+		g_FrameProfiler->BeginFrame();
+
+		// Enable z-depth
+		glEnable(GL_DEPTH_TEST);
+
+		// Clear the frame and z buffers
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+		// render the shared retained scene once per view - each
+		// extra view re-culls and re-rasterizes, nothing else
+		for (int view = 0; view < g_ViewManager->GetViewCount(); view++)
+		{
+			// convert from 3D object space to 2D view
+			g_FrameProfiler->BeginStage(FrameProfiler::STAGE_VIEW);
+			g_ViewManager->PrepareSceneView(view);
+			g_FrameProfiler->EndStage(FrameProfiler::STAGE_VIEW);
+
+			// hand the camera state to the scene manager so the
+			// culling pass can filter the draw list
+			g_SceneManager->SetFrameCamera(
+				g_ViewManager->GetViewMatrix(),
+				g_ViewManager->GetProjectionMatrix(),
+				g_ViewManager->GetCameraPosition());
+
+			// refresh the 3D scene - the GPU timer query brackets
+			// the draw submission
+			g_FrameProfiler->BeginStage(FrameProfiler::STAGE_RENDER);
+			g_FrameProfiler->BeginGPUTimer();
+			g_SceneManager->RenderScene();
+			g_FrameProfiler->EndGPUTimer();
+			g_FrameProfiler->EndStage(FrameProfiler::STAGE_RENDER);
+		}
+
+		// Flips the the back buffer with the front buffer every frame.
+		g_FrameProfiler->BeginStage(FrameProfiler::STAGE_SWAP);
+		glfwSwapBuffers(g_Window);
+		g_FrameProfiler->EndStage(FrameProfiler::STAGE_SWAP);
+
+		// query the latest GLFW events
+		glfwPollEvents();
+
+		g_FrameProfiler->EndFrame();
+	}
+
+	// write the benchmark results and compare them against the
+	// saved baseline before tearing down
+	if (true == g_bBenchmarkMode)
+	{
+		WriteBenchmarkResults(BENCHMARK_RESULTS_FILENAME);
+		CompareBenchmarkBaseline(BENCHMARK_BASELINE_FILENAME);
+	}
+
+	// write the aggregated frame timing before tearing down
+	if (NULL != g_FrameProfiler)
+	{
+		g_FrameProfiler->WriteReport(TIMING_REPORT_FILENAME);
+		delete g_FrameProfiler;
+		g_FrameProfiler = NULL;
+	}
+
+	// clear the allocated manager objects from memory
+	if (NULL != g_SceneManager)
+	{
+		delete g_SceneManager;
+		g_SceneManager = NULL;
+	}
+	if (NULL != g_ViewManager)
+	{
+		delete g_ViewManager;
+		g_ViewManager = NULL;
+	}
+	if (NULL != g_ShaderManager)
+	{
+		delete g_ShaderManager;
+		g_ShaderManager = NULL;
+	}
+
+	// Terminates the program successfully
+	exit(EXIT_SUCCESS); 
+}
+
+/***********************************************************
+ *	InitializeGLFW()
+ * 
+ *  This function is used to initialize the GLFW library.   
+ ***********************************************************/
+bool InitializeGLFW()
+{
+	// GLFW: initialize and configure library
+	// --------------------------------------
+	glfwInit();
+
+#ifdef __APPLE__
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
+	glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+#else
+	// set the version of OpenGL and profile to use
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+	glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+	glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+#endif
+
+	// headless batch rendering draws into an offscreen
+	// framebuffer - no visible window is needed
+	if (true == g_bHeadlessMode)
+	{
+		glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+	}
+	// GLFW: end -------------------------------
+
+	return(true);
+}
+
+/***********************************************************
+ *	InitializeGLEW()
+ *
+ *  This function is used to initialize the GLEW library.
+ ***********************************************************/
+bool InitializeGLEW()
+{
+	// GLEW: initialize
+	// -----------------------------------------
+	GLenum GLEWInitResult = GLEW_OK;
+
+	// try to initialize the GLEW library
+	GLEWInitResult = glewInit();
+	if (GLEW_OK != GLEWInitResult)
+	{
+		std::cerr << glewGetErrorString(GLEWInitResult) << std::endl;
+		return false;
+	}
+	// GLEW: end -------------------------------
+
+	// Displays a successful OpenGL initialization message
+	std::cout << "INFO: OpenGL Successfully Initialized\n";
+	std::cout << "INFO: OpenGL Version: " << glGetString(GL_VERSION) << "\n" << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *	RunBatchRender()
+ *
+ *  This function is used to render a fixed number of frames
+ *  into an offscreen framebuffer, reading each finished
+ *  frame back through a ring of pixel buffer objects so the
+ *  readback of frame N overlaps the rendering of frame N+1.
+ ***********************************************************/
+int RunBatchRender(int frameCount)
+{
+	int width = 0;
+	int height = 0;
+	GLuint framebufferID = 0;
+	GLuint colorBufferID = 0;
+	GLuint depthBufferID = 0;
+	GLuint readbackBuffers[READBACK_RING_SIZE];
+
+	glfwGetFramebufferSize(g_Window, &width, &height);
+
+	// create the offscreen framebuffer with color and depth
+	// attachments matching the window dimensions
+	glGenFramebuffers(1, &framebufferID);
+	glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+
+	glGenRenderbuffers(1, &colorBufferID);
+	glBindRenderbuffer(GL_RENDERBUFFER, colorBufferID);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorBufferID);
+
+	glGenRenderbuffers(1, &depthBufferID);
+	glBindRenderbuffer(GL_RENDERBUFFER, depthBufferID);
+	glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBufferID);
+
+	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+	{
+		std::cerr << "Failed to create offscreen framebuffer" << std::endl;
+		return(EXIT_FAILURE);
+	}
+
+	// create the ring of pixel buffer objects for the
+	// asynchronous frame readback
+	glGenBuffers(READBACK_RING_SIZE, readbackBuffers);
+	for (int i = 0; i < READBACK_RING_SIZE; i++)
+	{
+		glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffers[i]);
+		glBufferData(GL_PIXEL_PACK_BUFFER, width * height * 4, NULL, GL_STREAM_READ);
+	}
+	glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+	std::cout << "INFO: headless batch render of " << frameCount << " frames at "
+		<< width << "x" << height << std::endl;
+
+	// start the capture worker that encodes the frames off
+	// the render thread
+	if (true == g_bCaptureMode)
+	{
+		g_FrameCapture = new FrameCapture();
+		g_FrameCapture->Start(width, height);
+	}
+
+	// render the requested frames - readback is issued into the
+	// ring and consumed a full ring length later, so the GPU is
+	// never drained between frames
+	for (int frame = 0; frame < frameCount + READBACK_RING_SIZE; frame++)
+	{
+		// consume the readback issued a ring length ago before
+		// its slot is reused below - by now the transfer has
+		// completed and the map does not stall
+		int completedFrame = frame - READBACK_RING_SIZE;
+		if ((completedFrame >= 0) && (true == g_bCaptureMode))
+		{
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffers[completedFrame % READBACK_RING_SIZE]);
+
+			unsigned char* pPixels = (unsigned char*)glMapBuffer(GL_PIXEL_PACK_BUFFER, GL_READ_ONLY);
+			if (NULL != pPixels)
+			{
+				// hand the mapped pixels to the capture worker -
+				// one memcpy here, the encoding and file write
+				// happen off the render thread
+				g_FrameCapture->Submit(completedFrame, pPixels);
+				glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+			}
+			glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+		}
+
+		if (frame < frameCount)
+		{
+			g_FrameProfiler->BeginFrame();
+
+			// the benchmark drives a fixed orbit so every run
+			// sees the identical camera path - the second half
+			// of the run is the steady-state allocation window
+			if (true == g_bBenchmarkMode)
+			{
+				g_ViewManager->SetOrbitCamera(
+					(float)frame * 0.25f, 12.0f, 6.0f);
+				if (frame == frameCount / 2)
+				{
+					g_SteadyAllocationStart = g_AllocationCount;
+					g_SteadyFrameCount = frameCount - frame;
+				}
+			}
+
+			glBindFramebuffer(GL_FRAMEBUFFER, framebufferID);
+			glViewport(0, 0, width, height);
+
+			// Enable z-depth
+			glEnable(GL_DEPTH_TEST);
+
+			// Clear the frame and z buffers
+			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			// render the shared retained scene once per view
+			for (int view = 0; view < g_ViewManager->GetViewCount(); view++)
+			{
+				// convert from 3D object space to 2D view
+				g_FrameProfiler->BeginStage(FrameProfiler::STAGE_VIEW);
+				g_ViewManager->PrepareSceneView(view);
+				g_FrameProfiler->EndStage(FrameProfiler::STAGE_VIEW);
+
+				// hand the camera state to the scene manager so the
+				// culling pass can filter the draw list
+				g_SceneManager->SetFrameCamera(
+					g_ViewManager->GetViewMatrix(),
+					g_ViewManager->GetProjectionMatrix(),
+					g_ViewManager->GetCameraPosition());
+
+				// refresh the 3D scene
+				g_FrameProfiler->BeginStage(FrameProfiler::STAGE_RENDER);
+				g_FrameProfiler->BeginGPUTimer();
+				g_SceneManager->RenderScene();
+				g_FrameProfiler->EndGPUTimer();
+				g_FrameProfiler->EndStage(FrameProfiler::STAGE_RENDER);
+			}
+
+			// issue the asynchronous readback for this frame -
+			// only a capture run pays for it, so the benchmark
+			// measures just the render path
+			if (true == g_bCaptureMode)
+			{
+				glReadBuffer(GL_COLOR_ATTACHMENT0);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, readbackBuffers[frame % READBACK_RING_SIZE]);
+				glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+				glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+			}
+
+			// keep the GLFW event queue drained so the process
+			// stays responsive to window-system messages
+			glfwPollEvents();
+
+			g_FrameProfiler->EndFrame();
+		}
+	}
+
+	// drain the capture queue before tearing anything down
+	if (NULL != g_FrameCapture)
+	{
+		g_FrameCapture->Stop();
+		delete g_FrameCapture;
+		g_FrameCapture = NULL;
+	}
+
+	// free the offscreen rendering resources
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	glDeleteBuffers(READBACK_RING_SIZE, readbackBuffers);
+	glDeleteRenderbuffers(1, &colorBufferID);
+	glDeleteRenderbuffers(1, &depthBufferID);
+	glDeleteFramebuffers(1, &framebufferID);
+
+	return(EXIT_SUCCESS);
+}
+
+/***********************************************************
+ *	WriteBenchmarkResults()
+ *
+ *  This function is used to write the benchmark run results
+ *  into a machine-readable key,value CSV file - the frame
+ *  time distribution plus the counters that the retained
+ *  render path maintains.
+ ***********************************************************/
+bool WriteBenchmarkResults(const char* filename)
+{
+	int lodSubstituted = 0;
+	int lodDropped = 0;
+	long uniformHits = 0;
+	long uniformMisses = 0;
+	double allocationsPerFrame = 0.0;
+
+	FILE* pFile = fopen(filename, "w");
+	if (NULL == pFile)
+	{
+		std::cerr << "Failed to write benchmark results " << filename << std::endl;
+		return(false);
+	}
+
+	g_SceneManager->GetLODCounts(lodSubstituted, lodDropped);
+	g_SceneManager->GetUniformCacheCounts(uniformHits, uniformMisses);
+	if (g_SteadyFrameCount > 0)
+	{
+		allocationsPerFrame =
+			(double)(g_AllocationCount - g_SteadyAllocationStart) /
+			(double)g_SteadyFrameCount;
+	}
+
+	fprintf(pFile, "key,value\n");
+	fprintf(pFile, "objects,%d\n", g_BenchmarkObjectCount);
+	fprintf(pFile, "materials,%d\n", g_BenchmarkMaterialCount);
+	fprintf(pFile, "textures,%d\n", g_BenchmarkTextureCount);
+	fprintf(pFile, "frames,%d\n", g_BatchFrameCount);
+	fprintf(pFile, "p50_ms,%.4f\n", g_FrameProfiler->GetFrameTimePercentile(0.50));
+	fprintf(pFile, "p95_ms,%.4f\n", g_FrameProfiler->GetFrameTimePercentile(0.95));
+	fprintf(pFile, "p99_ms,%.4f\n", g_FrameProfiler->GetFrameTimePercentile(0.99));
+	fprintf(pFile, "culled_objects,%d\n", g_SceneManager->GetLastCulledCount());
+	fprintf(pFile, "lod_substituted,%d\n", lodSubstituted);
+	fprintf(pFile, "lod_dropped,%d\n", lodDropped);
+	fprintf(pFile, "uniforms_skipped,%ld\n", uniformHits);
+	fprintf(pFile, "uniforms_sent,%ld\n", uniformMisses);
+	fprintf(pFile, "allocations_per_frame,%.2f\n", allocationsPerFrame);
+	fprintf(pFile, "gpu_texture_bytes,%zu\n",
+		GpuResourceTracker::GetBytes(GpuResourceTracker::CATEGORY_TEXTURE));
+	fprintf(pFile, "gpu_instance_buffer_bytes,%zu\n",
+		GpuResourceTracker::GetBytes(GpuResourceTracker::CATEGORY_INSTANCE_BUFFER));
+	fclose(pFile);
+
+	std::cout << "INFO: wrote benchmark results:" << filename << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *	CompareBenchmarkBaseline()
+ *
+ *  This function is used to compare the benchmark frame time
+ *  percentiles against a saved baseline file and report the
+ *  change - copy a good benchmark_results.csv over the
+ *  baseline file to accept new numbers.
+ ***********************************************************/
+void CompareBenchmarkBaseline(const char* baselineFilename)
+{
+	char line[128];
+	char key[64];
+	double value = 0.0;
+	double baselineP50 = 0.0;
+	double baselineP95 = 0.0;
+
+	FILE* pFile = fopen(baselineFilename, "r");
+	if (NULL == pFile)
+	{
+		std::cout << "INFO: no benchmark baseline - copy "
+			<< BENCHMARK_RESULTS_FILENAME << " to "
+			<< baselineFilename << " to save one" << std::endl;
+		return;
+	}
+
+	while (fgets(line, sizeof(line), pFile) != NULL)
+	{
+		if (sscanf(line, "%63[^,],%lf", key, &value) != 2)
+		{
+			continue;
+		}
+		if (strcmp(key, "p50_ms") == 0)
+		{
+			baselineP50 = value;
+		}
+		else if (strcmp(key, "p95_ms") == 0)
+		{
+			baselineP95 = value;
+		}
+	}
+	fclose(pFile);
+
+	if ((baselineP50 <= 0.0) || (baselineP95 <= 0.0))
+	{
+		std::cout << "INFO: benchmark baseline has no percentiles:" << baselineFilename << std::endl;
+		return;
+	}
+
+	double currentP50 = g_FrameProfiler->GetFrameTimePercentile(0.50);
+	double currentP95 = g_FrameProfiler->GetFrameTimePercentile(0.95);
+
+	std::cout << "INFO: benchmark vs baseline - p50:"
+		<< currentP50 << "ms (" << ((currentP50 / baselineP50) - 1.0) * 100.0
+		<< "%) p95:" << currentP95 << "ms ("
+		<< ((currentP95 / baselineP95) - 1.0) * 100.0 << "%)" << std::endl;
+}
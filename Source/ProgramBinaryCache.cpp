@@ -0,0 +1,172 @@
+///////////////////////////////////////////////////////////////////////////////
+// programbinarycache.cpp
+// ============
+// cache compiled shader program binaries on disk between launches
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ProgramBinaryCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <sys/stat.h>
+
+// declaration of global variables
+namespace
+{
+	// FNV-1a hash constants
+	const uint32_t HASH_SEED = 2166136261u;
+	const uint32_t HASH_PRIME = 16777619u;
+
+	// the header at the front of a program binary cache file
+	struct CACHE_HEADER
+	{
+		uint32_t binaryFormat;
+		uint32_t binaryLength;
+	};
+}
+
+/***********************************************************
+ *  SaveCurrentProgram()
+ *
+ *  This method is used for saving the currently bound shader
+ *  program's binary into the cache file keyed by the passed
+ *  in shader sources.  When a cache file for this exact
+ *  source/driver combination already exists nothing is
+ *  written - the file is ready for a glProgramBinary load
+ *  path to consume on the next launch.
+ ***********************************************************/
+bool ProgramBinaryCache::SaveCurrentProgram(
+	const char* vertexShaderFilename,
+	const char* fragmentShaderFilename)
+{
+	struct stat fileInfo;
+	GLint programID = 0;
+	GLint binaryLength = 0;
+	GLenum binaryFormat = 0;
+	GLsizei writtenLength = 0;
+	CACHE_HEADER header;
+
+	std::string cacheFilename = GetCacheFilename(
+		vertexShaderFilename, fragmentShaderFilename);
+
+	// the cache key covers the sources and the driver, so an
+	// existing file is current by construction
+	if (stat(cacheFilename.c_str(), &fileInfo) == 0)
+	{
+		std::cout << "INFO: shader binary cache current:" << cacheFilename << std::endl;
+		return(true);
+	}
+
+	glGetIntegerv(GL_CURRENT_PROGRAM, &programID);
+	if (0 == programID)
+	{
+		return(false);
+	}
+
+	glGetProgramiv(programID, GL_PROGRAM_BINARY_LENGTH, &binaryLength);
+	if (binaryLength <= 0)
+	{
+		std::cout << "Driver does not expose a program binary" << std::endl;
+		return(false);
+	}
+
+	std::vector<unsigned char> binary(binaryLength);
+	glGetProgramBinary(programID, binaryLength, &writtenLength,
+		&binaryFormat, binary.data());
+
+	FILE* pFile = fopen(cacheFilename.c_str(), "wb");
+	if (NULL == pFile)
+	{
+		std::cout << "Could not write shader binary cache:" << cacheFilename << std::endl;
+		return(false);
+	}
+
+	header.binaryFormat = (uint32_t)binaryFormat;
+	header.binaryLength = (uint32_t)writtenLength;
+
+	fwrite(&header, sizeof(header), 1, pFile);
+	fwrite(binary.data(), 1, writtenLength, pFile);
+	fclose(pFile);
+
+	std::cout << "INFO: wrote shader binary cache:" << cacheFilename
+		<< ", bytes:" << writtenLength << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetCacheFilename()
+ *
+ *  This method is used for building the cache filename from
+ *  the hash of the shader sources and the driver strings -
+ *  a driver update or source edit changes the filename, so
+ *  stale binaries are simply never found.
+ ***********************************************************/
+std::string ProgramBinaryCache::GetCacheFilename(
+	const char* vertexShaderFilename,
+	const char* fragmentShaderFilename)
+{
+	uint32_t hash = HASH_SEED;
+	const GLubyte* pVersion = glGetString(GL_VERSION);
+	const GLubyte* pRenderer = glGetString(GL_RENDERER);
+	char filename[64];
+
+	HashFile(vertexShaderFilename, hash);
+	HashFile(fragmentShaderFilename, hash);
+	if (NULL != pVersion)
+	{
+		HashBytes(pVersion, strlen((const char*)pVersion), hash);
+	}
+	if (NULL != pRenderer)
+	{
+		HashBytes(pRenderer, strlen((const char*)pRenderer), hash);
+	}
+
+	snprintf(filename, sizeof(filename), "shader_%08x.bin", hash);
+
+	return(std::string(filename));
+}
+
+/***********************************************************
+ *  HashFile()
+ *
+ *  This method is used for folding a file's bytes into the
+ *  running hash value.
+ ***********************************************************/
+bool ProgramBinaryCache::HashFile(const char* filename, uint32_t& hash)
+{
+	char buffer[4096];
+	size_t bytesRead = 0;
+
+	FILE* pFile = fopen(filename, "rb");
+	if (NULL == pFile)
+	{
+		return(false);
+	}
+
+	while ((bytesRead = fread(buffer, 1, sizeof(buffer), pFile)) > 0)
+	{
+		HashBytes(buffer, bytesRead, hash);
+	}
+	fclose(pFile);
+
+	return(true);
+}
+
+/***********************************************************
+ *  HashBytes()
+ *
+ *  This method is used for folding the passed in bytes into
+ *  the running FNV-1a hash value.
+ ***********************************************************/
+void ProgramBinaryCache::HashBytes(const void* pData, size_t bytes, uint32_t& hash)
+{
+	const unsigned char* pBytes = (const unsigned char*)pData;
+
+	for (size_t i = 0; i < bytes; i++)
+	{
+		hash = (hash ^ pBytes[i]) * HASH_PRIME;
+	}
+}
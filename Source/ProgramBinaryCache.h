@@ -0,0 +1,46 @@
+///////////////////////////////////////////////////////////////////////////////
+// programbinarycache.h
+// ============
+// cache compiled shader program binaries on disk between launches
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstdint>
+#include <string>
+
+/***********************************************************
+ *  ProgramBinaryCache
+ *
+ *  This class contains the code for saving the compiled
+ *  shader program binary to disk, keyed by a hash of the
+ *  shader sources and the driver identification strings so
+ *  a stale binary is never matched.  The cache file is what
+ *  lets a shader loader skip GLSL compilation on later
+ *  launches via glProgramBinary.
+ ***********************************************************/
+class ProgramBinaryCache
+{
+public:
+	// save the currently bound shader program's binary into
+	// the cache file for the passed in shader sources - a
+	// no-op when a current cache file already exists
+	static bool SaveCurrentProgram(
+		const char* vertexShaderFilename,
+		const char* fragmentShaderFilename);
+
+private:
+	// build the cache filename from the hash of the shader
+	// sources and the driver identification strings
+	static std::string GetCacheFilename(
+		const char* vertexShaderFilename,
+		const char* fragmentShaderFilename);
+
+	// fold a file's bytes into the running hash value
+	static bool HashFile(const char* filename, uint32_t& hash);
+
+	// fold a string's bytes into the running hash value
+	static void HashBytes(const void* pData, size_t bytes, uint32_t& hash);
+};
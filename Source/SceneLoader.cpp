@@ -0,0 +1,379 @@
+///////////////////////////////////////////////////////////////////////////////
+// sceneloader.cpp
+// ============
+// load 3D scene descriptions from editable scene files and binary caches
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneLoader.h"
+
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <mutex>
+#include <sys/stat.h>
+
+// declaration of global variables
+namespace
+{
+	// magic value and version for the binary scene cache - the
+	// version must change whenever SCENE_RECORD changes layout
+	const uint32_t CACHE_MAGIC = 0x424E4353;	// 'SCNB'
+	const uint32_t CACHE_VERSION = 1;
+
+	// the header at the front of a binary scene cache file
+	struct CACHE_HEADER
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint32_t recordCount;
+		uint32_t reserved;
+	};
+
+	// copy a tag string into a fixed-size record field
+	void CopyTag(char* pDestination, const char* pSource, int length)
+	{
+		strncpy(pDestination, pSource, length - 1);
+		pDestination[length - 1] = '\0';
+	}
+
+	// scene records loaded ahead of time by a startup worker
+	// thread, consumed by the next matching LoadSceneRecords()
+	std::mutex g_PreloadMutex;
+	std::string g_PreloadedFilename;
+	std::vector<SceneLoader::SCENE_RECORD> g_PreloadedRecords;
+	bool g_bPreloadReady = false;
+}
+
+/***********************************************************
+ *  LoadSceneRecords()
+ *
+ *  This method is used for loading the scene records for the
+ *  passed in scene file.  The flat binary cache is used when
+ *  it is up to date, so production nodes never pay for text
+ *  parsing - otherwise the text file is parsed and the cache
+ *  is rewritten for the next launch.
+ ***********************************************************/
+bool SceneLoader::LoadSceneRecords(
+	const char* sceneFilename,
+	std::vector<SCENE_RECORD>& records)
+{
+	std::string cacheFilename = GetCacheFilename(sceneFilename);
+
+	// fastest path - a startup worker already loaded the
+	// records while the GL context was being created
+	{
+		std::lock_guard<std::mutex> lock(g_PreloadMutex);
+
+		if ((true == g_bPreloadReady) &&
+			(g_PreloadedFilename == sceneFilename))
+		{
+			records.swap(g_PreloadedRecords);
+			g_PreloadedRecords.clear();
+			g_bPreloadReady = false;
+
+			std::cout << "INFO: consumed preloaded scene:" << sceneFilename
+				<< ", objects:" << records.size() << std::endl;
+			return(true);
+		}
+	}
+
+	// fast path - read the flat records straight from the cache
+	if (IsCacheCurrent(sceneFilename, cacheFilename.c_str()))
+	{
+		if (LoadBinaryCache(cacheFilename.c_str(), records))
+		{
+			std::cout << "INFO: loaded scene cache:" << cacheFilename
+				<< ", objects:" << records.size() << std::endl;
+			return(true);
+		}
+	}
+
+	// slow path - parse the editable scene file
+	if (ParseSceneFile(sceneFilename, records) == false)
+	{
+		return(false);
+	}
+
+	std::cout << "INFO: parsed scene file:" << sceneFilename
+		<< ", objects:" << records.size() << std::endl;
+
+	// rewrite the cache so the next launch takes the fast path
+	SaveBinaryCache(cacheFilename.c_str(), records);
+
+	return(true);
+}
+
+/***********************************************************
+ *  PreloadSceneRecords()
+ *
+ *  This method is used for loading the scene records ahead
+ *  of time on a startup worker thread - pure CPU and disk
+ *  work, so it runs concurrently with window creation and
+ *  shader compilation.
+ ***********************************************************/
+void SceneLoader::PreloadSceneRecords(const char* sceneFilename)
+{
+	std::vector<SCENE_RECORD> records;
+
+	if (LoadSceneRecords(sceneFilename, records) == false)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(g_PreloadMutex);
+	g_PreloadedFilename = sceneFilename;
+	g_PreloadedRecords.swap(records);
+	g_bPreloadReady = true;
+}
+
+/***********************************************************
+ *  ParseSceneFile()
+ *
+ *  This method is used for parsing the human-editable scene
+ *  file format.  The format is line based:
+ *
+ *    # comment
+ *    material <tag>
+ *    texture <tag> <u> <v>
+ *    color <r> <g> <b> <a>
+ *    object <plane|box|sphere|cylinder> <sx> <sy> <sz>
+ *           <rx> <ry> <rz> <px> <py> <pz>
+ *
+ *  The material/texture/color lines set the shading state
+ *  that each following object line is recorded with - color
+ *  turns texturing off, matching the authoring API.
+ ***********************************************************/
+bool SceneLoader::ParseSceneFile(
+	const char* sceneFilename,
+	std::vector<SCENE_RECORD>& records)
+{
+	char line[256];
+	char token[64];
+	int lineNumber = 0;
+
+	// the shading state carried between object lines
+	char materialTag[TAG_LENGTH] = "";
+	char textureTag[TAG_LENGTH] = "";
+	int bUseTexture = 0;
+	float uvScale[2] = { 1.0f, 1.0f };
+	float color[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+
+	FILE* pFile = fopen(sceneFilename, "r");
+	if (NULL == pFile)
+	{
+		std::cout << "Could not load scene file:" << sceneFilename << std::endl;
+		return(false);
+	}
+
+	while (fgets(line, sizeof(line), pFile) != NULL)
+	{
+		lineNumber++;
+
+		// skip blank lines and comments
+		if (sscanf(line, " %63s", token) != 1)
+		{
+			continue;
+		}
+		if (token[0] == '#')
+		{
+			continue;
+		}
+
+		if (strcmp(token, "material") == 0)
+		{
+			if (sscanf(line, " material %31s", materialTag) != 1)
+			{
+				std::cout << "Bad material line " << lineNumber << " in scene file:" << sceneFilename << std::endl;
+			}
+		}
+		else if (strcmp(token, "texture") == 0)
+		{
+			if (sscanf(line, " texture %31s %f %f", textureTag, &uvScale[0], &uvScale[1]) != 3)
+			{
+				std::cout << "Bad texture line " << lineNumber << " in scene file:" << sceneFilename << std::endl;
+			}
+			else
+			{
+				bUseTexture = 1;
+			}
+		}
+		else if (strcmp(token, "color") == 0)
+		{
+			if (sscanf(line, " color %f %f %f %f", &color[0], &color[1], &color[2], &color[3]) != 4)
+			{
+				std::cout << "Bad color line " << lineNumber << " in scene file:" << sceneFilename << std::endl;
+			}
+			else
+			{
+				// setting a color turns texturing off, matching
+				// the authoring API semantics
+				bUseTexture = 0;
+			}
+		}
+		else if (strcmp(token, "object") == 0)
+		{
+			SCENE_RECORD record;
+			char meshName[64];
+
+			memset(&record, 0, sizeof(record));
+
+			if (sscanf(line, " object %63s %f %f %f %f %f %f %f %f %f",
+				meshName,
+				&record.scaleXYZ[0], &record.scaleXYZ[1], &record.scaleXYZ[2],
+				&record.rotationDegreesXYZ[0], &record.rotationDegreesXYZ[1], &record.rotationDegreesXYZ[2],
+				&record.positionXYZ[0], &record.positionXYZ[1], &record.positionXYZ[2]) != 10)
+			{
+				std::cout << "Bad object line " << lineNumber << " in scene file:" << sceneFilename << std::endl;
+				continue;
+			}
+
+			// map the mesh name onto its record id - the ids
+			// match the SceneManager MESH_ID ordering
+			if (strcmp(meshName, "plane") == 0)
+				record.meshID = 0;
+			else if (strcmp(meshName, "box") == 0)
+				record.meshID = 1;
+			else if (strcmp(meshName, "sphere") == 0)
+				record.meshID = 2;
+			else if (strcmp(meshName, "cylinder") == 0)
+				record.meshID = 3;
+			else
+			{
+				std::cout << "Unknown mesh " << meshName << " on line " << lineNumber << " in scene file:" << sceneFilename << std::endl;
+				continue;
+			}
+
+			// record the current shading state with the object
+			CopyTag(record.materialTag, materialTag, TAG_LENGTH);
+			CopyTag(record.textureTag, textureTag, TAG_LENGTH);
+			record.bUseTexture = bUseTexture;
+			record.uvScale[0] = uvScale[0];
+			record.uvScale[1] = uvScale[1];
+			memcpy(record.color, color, sizeof(record.color));
+
+			records.push_back(record);
+		}
+		else
+		{
+			std::cout << "Unknown keyword " << token << " on line " << lineNumber << " in scene file:" << sceneFilename << std::endl;
+		}
+	}
+
+	fclose(pFile);
+
+	return(records.size() > 0);
+}
+
+/***********************************************************
+ *  LoadBinaryCache()
+ *
+ *  This method is used for reading the flat scene records
+ *  from the binary cache file - a single header check and
+ *  one read of the whole record array.
+ ***********************************************************/
+bool SceneLoader::LoadBinaryCache(
+	const char* cacheFilename,
+	std::vector<SCENE_RECORD>& records)
+{
+	CACHE_HEADER header;
+
+	FILE* pFile = fopen(cacheFilename, "rb");
+	if (NULL == pFile)
+	{
+		return(false);
+	}
+
+	// validate the cache header before trusting the records
+	if ((fread(&header, sizeof(header), 1, pFile) != 1) ||
+		(header.magic != CACHE_MAGIC) ||
+		(header.version != CACHE_VERSION))
+	{
+		std::cout << "Stale or invalid scene cache:" << cacheFilename << std::endl;
+		fclose(pFile);
+		return(false);
+	}
+
+	// read the whole flat record array in one call
+	records.resize(header.recordCount);
+	if (fread(records.data(), sizeof(SCENE_RECORD), header.recordCount, pFile) != header.recordCount)
+	{
+		std::cout << "Truncated scene cache:" << cacheFilename << std::endl;
+		records.clear();
+		fclose(pFile);
+		return(false);
+	}
+
+	fclose(pFile);
+
+	return(true);
+}
+
+/***********************************************************
+ *  SaveBinaryCache()
+ *
+ *  This method is used for writing the flat scene records
+ *  into the versioned binary cache file.
+ ***********************************************************/
+bool SceneLoader::SaveBinaryCache(
+	const char* cacheFilename,
+	const std::vector<SCENE_RECORD>& records)
+{
+	CACHE_HEADER header;
+
+	FILE* pFile = fopen(cacheFilename, "wb");
+	if (NULL == pFile)
+	{
+		std::cout << "Could not write scene cache:" << cacheFilename << std::endl;
+		return(false);
+	}
+
+	header.magic = CACHE_MAGIC;
+	header.version = CACHE_VERSION;
+	header.recordCount = (uint32_t)records.size();
+	header.reserved = 0;
+
+	fwrite(&header, sizeof(header), 1, pFile);
+	fwrite(records.data(), sizeof(SCENE_RECORD), records.size(), pFile);
+	fclose(pFile);
+
+	std::cout << "INFO: wrote scene cache:" << cacheFilename << std::endl;
+
+	return(true);
+}
+
+/***********************************************************
+ *  GetCacheFilename()
+ *
+ *  This method is used for getting the name of the binary
+ *  cache file that pairs with a scene file.
+ ***********************************************************/
+std::string SceneLoader::GetCacheFilename(const char* sceneFilename)
+{
+	return(std::string(sceneFilename) + "bin");
+}
+
+/***********************************************************
+ *  IsCacheCurrent()
+ *
+ *  This method is used for checking whether the binary cache
+ *  file is newer than the scene file it was built from.
+ ***********************************************************/
+bool SceneLoader::IsCacheCurrent(
+	const char* sceneFilename,
+	const char* cacheFilename)
+{
+	struct stat sceneInfo;
+	struct stat cacheInfo;
+
+	if (stat(cacheFilename, &cacheInfo) != 0)
+	{
+		return(false);
+	}
+	if (stat(sceneFilename, &sceneInfo) != 0)
+	{
+		// no editable scene file - trust the cache
+		return(true);
+	}
+
+	return(cacheInfo.st_mtime >= sceneInfo.st_mtime);
+}
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+// sceneloader.h
+// ============
+// load 3D scene descriptions from editable scene files and binary caches
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/***********************************************************
+ *  SceneLoader
+ *
+ *  This class contains the code for parsing human-editable
+ *  scene description files into flat draw records, and for
+ *  reading/writing the versioned binary cache that lets
+ *  production nodes skip parsing entirely.
+ ***********************************************************/
+class SceneLoader
+{
+public:
+	// maximum length of a material or texture tag inside a
+	// flat binary scene record
+	static const int TAG_LENGTH = 32;
+
+	// one flat scene record - fixed size with no pointers so
+	// the binary cache is a straight array of these
+	struct SCENE_RECORD
+	{
+		int32_t meshID;
+		float scaleXYZ[3];
+		float rotationDegreesXYZ[3];
+		float positionXYZ[3];
+		char materialTag[TAG_LENGTH];
+		int32_t bUseTexture;
+		char textureTag[TAG_LENGTH];
+		float uvScale[2];
+		float color[4];
+	};
+
+	// load the scene records for the passed in scene file -
+	// the binary cache is used when it is up to date, else the
+	// text file is parsed and the cache rewritten
+	static bool LoadSceneRecords(
+		const char* sceneFilename,
+		std::vector<SCENE_RECORD>& records);
+
+	// load the scene records ahead of time on a startup
+	// worker thread - a later LoadSceneRecords() call for the
+	// same file consumes the preloaded records without
+	// touching the disk again
+	static void PreloadSceneRecords(const char* sceneFilename);
+
+private:
+	// parse the human-editable text scene file
+	static bool ParseSceneFile(
+		const char* sceneFilename,
+		std::vector<SCENE_RECORD>& records);
+
+	// read the flat records from the binary cache file
+	static bool LoadBinaryCache(
+		const char* cacheFilename,
+		std::vector<SCENE_RECORD>& records);
+
+	// write the flat records into the binary cache file
+	static bool SaveBinaryCache(
+		const char* cacheFilename,
+		const std::vector<SCENE_RECORD>& records);
+
+	// get the name of the binary cache file for a scene file
+	static std::string GetCacheFilename(const char* sceneFilename);
+
+	// returns true when the cache file is newer than the
+	// scene file it was built from
+	static bool IsCacheCurrent(
+		const char* sceneFilename,
+		const char* cacheFilename);
+};
@@ -1,745 +1,3150 @@
-///////////////////////////////////////////////////////////////////////////////
-// scenemanager.cpp
-// ============
-// manage the preparing and rendering of 3D scenes - textures, materials, lighting
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include "SceneManager.h"
-
-#ifndef STB_IMAGE_IMPLEMENTATION
-#define STB_IMAGE_IMPLEMENTATION
-#include "stb_image.h"
-#endif
-
-#include <glm/gtx/transform.hpp>
-
-// declaration of global variables
-namespace
-{
-	const char* g_ModelName = "model";
-	const char* g_ColorValueName = "objectColor";
-	const char* g_TextureValueName = "objectTexture";
-	const char* g_UseTextureName = "bUseTexture";
-	const char* g_UseLightingName = "bUseLighting";
-}
-
-/***********************************************************
- *  SceneManager()
- *
- *  The constructor for the class
- ***********************************************************/
-SceneManager::SceneManager(ShaderManager *pShaderManager)
-{
-	m_pShaderManager = pShaderManager;
-	m_basicMeshes = new ShapeMeshes();
-}
-
-/***********************************************************
- *  ~SceneManager()
- *
- *  The destructor for the class
- ***********************************************************/
-SceneManager::~SceneManager()
-{
-	m_pShaderManager = NULL;
-	delete m_basicMeshes;
-	m_basicMeshes = NULL;
-}
-
-/***********************************************************
- *  CreateGLTexture()
- *
- *  This method is used for loading textures from image files,
- *  configuring the texture mapping parameters in OpenGL,
- *  generating the mipmaps, and loading the read texture into
- *  the next available texture slot in memory.
- ***********************************************************/
-bool SceneManager::CreateGLTexture(const char* filename, std::string tag)
-{
-	int width = 0;
-	int height = 0;
-	int colorChannels = 0;
-	GLuint textureID = 0;
-
-	// indicate to always flip images vertically when loaded
-	stbi_set_flip_vertically_on_load(true);
-
-	// try to parse the image data from the specified image file
-	unsigned char* image = stbi_load(
-		filename,
-		&width,
-		&height,
-		&colorChannels,
-		0);
-
-	// if the image was successfully read from the image file
-	if (image)
-	{
-		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
-
-		glGenTextures(1, &textureID);
-		glBindTexture(GL_TEXTURE_2D, textureID);
-
-		// set the texture wrapping parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		// set texture filtering parameters
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-		// if the loaded image is in RGB format
-		if (colorChannels == 3)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
-		// if the loaded image is in RGBA format - it supports transparency
-		else if (colorChannels == 4)
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
-		else
-		{
-			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
-			return false;
-		}
-
-		// generate the texture mipmaps for mapping textures to lower resolutions
-		glGenerateMipmap(GL_TEXTURE_2D);
-
-		// free the image data from local memory
-		stbi_image_free(image);
-		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
-
-		// register the loaded texture and associate it with the special tag string
-		m_textureIDs[m_loadedTextures].ID = textureID;
-		m_textureIDs[m_loadedTextures].tag = tag;
-		m_loadedTextures++;
-
-		return true;
-	}
-
-	std::cout << "Could not load image:" << filename << std::endl;
-
-	// Error loading the image
-	return false;
-}
-
-/***********************************************************
- *  BindGLTextures()
- *
- *  This method is used for binding the loaded textures to
- *  OpenGL texture memory slots.  There are up to 16 slots.
- ***********************************************************/
-void SceneManager::BindGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		// bind textures on corresponding texture units
-		glActiveTexture(GL_TEXTURE0 + i);
-		glBindTexture(GL_TEXTURE_2D, m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  DestroyGLTextures()
- *
- *  This method is used for freeing the memory in all the
- *  used texture memory slots.
- ***********************************************************/
-void SceneManager::DestroyGLTextures()
-{
-	for (int i = 0; i < m_loadedTextures; i++)
-	{
-		glGenTextures(1, &m_textureIDs[i].ID);
-	}
-}
-
-/***********************************************************
- *  FindTextureID()
- *
- *  This method is used for getting an ID for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureID(std::string tag)
-{
-	int textureID = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureID = m_textureIDs[index].ID;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureID);
-}
-
-/***********************************************************
- *  FindTextureSlot()
- *
- *  This method is used for getting a slot index for the previously
- *  loaded texture bitmap associated with the passed in tag.
- ***********************************************************/
-int SceneManager::FindTextureSlot(std::string tag)
-{
-	int textureSlot = -1;
-	int index = 0;
-	bool bFound = false;
-
-	while ((index < m_loadedTextures) && (bFound == false))
-	{
-		if (m_textureIDs[index].tag.compare(tag) == 0)
-		{
-			textureSlot = index;
-			bFound = true;
-		}
-		else
-			index++;
-	}
-
-	return(textureSlot);
-}
-
-/***********************************************************
- *  FindMaterial()
- *
- *  This method is used for getting a material from the previously
- *  defined materials list that is associated with the passed in tag.
- ***********************************************************/
-bool SceneManager::FindMaterial(std::string tag, OBJECT_MATERIAL& material)
-{
-	if (m_objectMaterials.size() == 0)
-	{
-		return(false);
-	}
-
-	int index = 0;
-	bool bFound = false;
-	while ((index < m_objectMaterials.size()) && (bFound == false))
-	{
-		if (m_objectMaterials[index].tag.compare(tag) == 0)
-		{
-			bFound = true;
-			material.diffuseColor = m_objectMaterials[index].diffuseColor;
-			material.specularColor = m_objectMaterials[index].specularColor;
-			material.shininess = m_objectMaterials[index].shininess;
-		}
-		else
-		{
-			index++;
-		}
-	}
-
-	return(true);
-}
-
-/***********************************************************
- *  SetTransformations()
- *
- *  This method is used for setting the transform buffer
- *  using the passed in transformation values.
- ***********************************************************/
-void SceneManager::SetTransformations(
-	glm::vec3 scaleXYZ,
-	float XrotationDegrees,
-	float YrotationDegrees,
-	float ZrotationDegrees,
-	glm::vec3 positionXYZ)
-{
-	// variables for this method
-	glm::mat4 modelView;
-	glm::mat4 scale;
-	glm::mat4 rotationX;
-	glm::mat4 rotationY;
-	glm::mat4 rotationZ;
-	glm::mat4 translation;
-
-	// set the scale value in the transform buffer
-	scale = glm::scale(scaleXYZ);
-	// set the rotation values in the transform buffer
-	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
-	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
-	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
-	// set the translation value in the transform buffer
-	translation = glm::translate(positionXYZ);
-
-	modelView = translation * rotationZ * rotationY * rotationX * scale;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setMat4Value(g_ModelName, modelView);
-	}
-}
-
-/***********************************************************
- *  SetShaderColor()
- *
- *  This method is used for setting the passed in color
- *  into the shader for the next draw command
- ***********************************************************/
-void SceneManager::SetShaderColor(
-	float redColorValue,
-	float greenColorValue,
-	float blueColorValue,
-	float alphaValue)
-{
-	// variables for this method
-	glm::vec4 currentColor;
-
-	currentColor.r = redColorValue;
-	currentColor.g = greenColorValue;
-	currentColor.b = blueColorValue;
-	currentColor.a = alphaValue;
-
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, false);
-		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
-	}
-}
-
-/***********************************************************
- *  SetShaderTexture()
- *
- *  This method is used for setting the texture data
- *  associated with the passed in ID into the shader.
- ***********************************************************/
-void SceneManager::SetShaderTexture(
-	std::string textureTag)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setIntValue(g_UseTextureName, true);
-
-		int textureID = -1;
-		textureID = FindTextureSlot(textureTag);
-		m_pShaderManager->setSampler2DValue(g_TextureValueName, textureID);
-	}
-}
-
-/***********************************************************
- *  SetTextureUVScale()
- *
- *  This method is used for setting the texture UV scale
- *  values into the shader.
- ***********************************************************/
-void SceneManager::SetTextureUVScale(float u, float v)
-{
-	if (NULL != m_pShaderManager)
-	{
-		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
-	}
-}
-
-/***********************************************************
- *  SetShaderMaterial()
- *
- *  This method is used for passing the material values
- *  into the shader.
- ***********************************************************/
-void SceneManager::SetShaderMaterial(
-	std::string materialTag)
-{
-	if (m_objectMaterials.size() > 0)
-	{
-		OBJECT_MATERIAL material;
-		bool bReturn = false;
-
-		bReturn = FindMaterial(materialTag, material);
-		if (bReturn == true)
-		{
-			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
-			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
-			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
-		}
-	}
-}
-
-/***********************************************************
- *  LoadSceneTextures()
- *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene
- *  rendering
- ***********************************************************/
-void SceneManager::LoadSceneTextures()
-{                
-	CreateGLTexture("textures/tableWood.jpg", "woodTexture");
-	CreateGLTexture("textures/glassTop.jpg", "glassTexture");
-	CreateGLTexture("textures/glassBottom.jpg", "glassTexture2");
-
-	// after the texture image data is loaded into memory, the
-	// loaded textures need to be bound to texture slots - there
-	// are a total of 16 available slots for scene textures
-
-	BindGLTextures();
-}
-
- /***********************************************************
-  *  DefineObjectMaterials()
-  *
-  *  This method is used for configuring the various material
-  *  settings for all of the objects within the 3D scene.
-  ***********************************************************/
-void SceneManager::DefineObjectMaterials()
-{
-// Cheese
-	OBJECT_MATERIAL cheese;
-	cheese.tag = "cheese";
-	cheese.diffuseColor = glm::vec3(1.0f, 0.85f, 0.3f);
-	cheese.specularColor = glm::vec3(0.9f, 0.8f, 0.4f);
-	cheese.shininess = 32.0f;
-	m_objectMaterials.push_back(cheese);
-
-	// Grapes
-	OBJECT_MATERIAL grapes;
-	grapes.tag = "grapes";
-	grapes.diffuseColor = glm::vec3(0.6f, 0.1f, 0.6f);
-	grapes.specularColor = glm::vec3(0.8f, 0.2f, 0.8f);
-	grapes.shininess = 32.0f;
-	m_objectMaterials.push_back(grapes);
-
-	// Cherries
-	OBJECT_MATERIAL cherries;
-	cherries.tag = "cherries";
-	cherries.diffuseColor = glm::vec3(1.0f, 0.0f, 0.0f);
-	cherries.specularColor = glm::vec3(0.9f, 0.1f, 0.1f);
-	cherries.shininess = 32.0f;
-	m_objectMaterials.push_back(cherries);
-
-	// Crackers
-	OBJECT_MATERIAL crackers;
-	crackers.tag = "crackers";
-	crackers.diffuseColor = glm::vec3(0.9f, 0.75f, 0.5f);
-	crackers.specularColor = glm::vec3(0.7f, 0.65f, 0.5f);
-	crackers.shininess = 8.0f;
-	m_objectMaterials.push_back(crackers);
-
-	// Glass
-	OBJECT_MATERIAL glass;
-	glass.tag = "glass";
-	glass.diffuseColor = glm::vec3(1.0f, 1.0f, 1.0f);
-	glass.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
-	glass.shininess = 500.0f;
-	m_objectMaterials.push_back(glass);
-
-	// Wood
-	OBJECT_MATERIAL wood;
-	wood.tag = "wood";
-	wood.diffuseColor = glm::vec3(0.7f, 0.45f, 0.2f); 
-	wood.specularColor = glm::vec3(0.3f, 0.2f, 0.1f);
-	wood.shininess = 16.0f;
-	m_objectMaterials.push_back(wood);
-}
-
-/***********************************************************
- *  SetupSceneLights()
- *
- *  This method is called to add and configure the light
- *  sources for the 3D scene.  There are up to 4 light sources.
- ***********************************************************/
-void SceneManager::SetupSceneLights()
-{
-	m_pShaderManager->setBoolValue(g_UseLightingName, true);
-
-	// Directional Light - main sunlight
-	m_pShaderManager->setVec3Value("directionalLight.direction", glm::vec3(-0.5f, -1.0f, -0.3f)); 
-	m_pShaderManager->setVec3Value("directionalLight.ambient", glm::vec3(0.35f, 0.35f, 0.35f)); 
-	m_pShaderManager->setVec3Value("directionalLight.diffuse", glm::vec3(1.0f, 0.92f, 0.75f)); 
-	m_pShaderManager->setVec3Value("directionalLight.specular", glm::vec3(1.0f, 1.0f, 1.0f)); 
-	m_pShaderManager->setBoolValue("directionalLight.bActive", true);
-
-	// Point Light - soft colored accent
-	m_pShaderManager->setVec3Value("pointLights[0].position", glm::vec3(0.25f, 0.25f, 0.15f));
-	m_pShaderManager->setVec3Value("pointLights[0].ambient", glm::vec3(0.05f, 0.02f, 0.03f));
-	m_pShaderManager->setVec3Value("pointLights[0].diffuse", glm::vec3(1.0f, 0.6f, 0.45f)); 
-	m_pShaderManager->setVec3Value("pointLights[0].specular", glm::vec3(1.0f, 0.7f, 0.5f)); 
-	m_pShaderManager->setBoolValue("pointLights[0].bActive", true);
-}
-
-/***********************************************************
- *  PrepareScene()
- *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene 
- *  rendering
- ***********************************************************/
-void SceneManager::PrepareScene()
-{
-	//define the materials for objects in the scene
-	DefineObjectMaterials();
-	//add and define the light sources for the scene
-	SetupSceneLights();
-	// load the textures for the 3D scene
-	LoadSceneTextures();
-
-	// only one instance of a particular mesh needs to be
-	// loaded in memory no matter how many times it is drawn
-	// in the rendered 3D scene
-
-	m_basicMeshes->LoadPlaneMesh();
-	m_basicMeshes->LoadCylinderMesh();
-	m_basicMeshes->LoadSphereMesh();
-	m_basicMeshes->LoadBoxMesh();
-
-}
-
-/***********************************************************
- *  RenderScene()
- *
- *  This method is used for rendering the 3D scene by 
- *  transforming and drawing the basic 3D shapes
- ***********************************************************/
-void SceneManager::RenderScene()
-{
-	// declare the variables for the transformations
-	glm::vec3 scaleXYZ;
-	float XrotationDegrees = 0.0f;
-	float YrotationDegrees = 0.0f;
-	float ZrotationDegrees = 0.0f;
-	glm::vec3 positionXYZ;
-
-	/*** Set needed transformations before drawing the basic mesh.  ***/
-	/*** This same ordering of code should be used for transforming ***/
-	/*** and drawing all the basic 3D shapes.						***/
-	/******************************************************************/
-
-	/**********************
-	 * Board 
-	 **********************/
-
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.5f, 0.02f, 0.65f); 
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ, 
-		XrotationDegrees,
-		YrotationDegrees, 
-		ZrotationDegrees, 
-		positionXYZ);
-
-	// set the texture for the next draw command
-	SetShaderTexture("woodTexture");
-	SetTextureUVScale(1.0f, 1.0f);
-	SetShaderMaterial("wood");
-
-	// draw the plane mesh
-	m_basicMeshes->DrawPlaneMesh();
-
-	/**********************
-	 * Cheese Slices Cluster
-	 **********************/
-
-	// set the XYZ positions for the mesh
-	glm::vec3 cheesePositions[] = {
-		glm::vec3(0.2f, 0.02f, 0.15f),
-		glm::vec3(0.25f, 0.02f, 0.18f),
-		glm::vec3(0.28f, 0.02f, 0.12f)
-	};
-
-	// set the XYZ rotations for the mesh
-	glm::vec3 cheeseRotations[] = {
-		glm::vec3(0.0f, 0.0f, 5.0f),
-		glm::vec3(0.0f, 10.0f, 0.0f),
-		glm::vec3(0.0f, 15.0f, -5.0f)
-	};
-
-	// set the rotation and shader for each cheese x3
-	for (int i = 0; i < 3; i++) {
-		scaleXYZ = glm::vec3(0.1f, 0.01f, 0.05f);
-		XrotationDegrees = cheeseRotations[i].x;
-		YrotationDegrees = cheeseRotations[i].y;
-		ZrotationDegrees = cheeseRotations[i].z;
-		positionXYZ = cheesePositions[i];
-		SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-		SetShaderMaterial("cheese");
-		m_basicMeshes->DrawBoxMesh();
-	}
-
-	/**********************
-	 * Grapes Cluster
-	 **********************/
-
-	// set the positions for the mesh
-	glm::vec3 grapePositions[] = {
-		glm::vec3(0.0f, 0.03f, 0.2f),
-		glm::vec3(0.025f, 0.03f, 0.215f),
-		glm::vec3(-0.02f, 0.03f, 0.185f),
-		glm::vec3(0.015f, 0.03f, 0.18f)
-	};
-
-	// set the rotation and shaders for each grape x4
-	for (int i = 0; i < 4; i++) {
-		scaleXYZ = glm::vec3(0.02f);
-		XrotationDegrees = 0.0f;
-		YrotationDegrees = 0.0f;
-		ZrotationDegrees = 0.0f;
-		positionXYZ = grapePositions[i];
-		SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-		SetShaderMaterial("grapes");
-		m_basicMeshes->DrawSphereMesh();
-	}
-
-	/**********************
-	 * Cherries Cluster
-	 **********************/
-
-	// set the positions for the mesh
-	glm::vec3 cherryPositions[] = {
-		glm::vec3(-0.1f, 0.03f, -0.05f),
-		glm::vec3(-0.08f, 0.03f, -0.07f),
-		glm::vec3(-0.115f, 0.03f, -0.045f)
-	};
-
-	// set the rotation and shaders for each cherry x3
-	for (int i = 0; i < 3; i++) {
-		scaleXYZ = glm::vec3(0.02f);
-		XrotationDegrees = 0.0f;
-		YrotationDegrees = 0.0f;
-		ZrotationDegrees = 0.0f;
-		positionXYZ = cherryPositions[i];
-		SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-		SetShaderMaterial("cherries");
-		m_basicMeshes->DrawSphereMesh();
-	}
-
-	/**********************
-	 * Crackers Cluster
-	 **********************/
-
-	// set the positions for the mesh
-	glm::vec3 crackerPositions[] = {
-		glm::vec3(-0.2f, 0.025f, 0.1f),
-		glm::vec3(-0.23f, 0.025f, 0.14f),
-		glm::vec3(-0.18f, 0.025f, 0.07f)
-	};
-
-	// set the rotations and shaders for each cracker x3
-	glm::vec3 crackerRotations[] = {
-		glm::vec3(0.0f, 0.0f, 10.0f),
-		glm::vec3(0.0f, 5.0f, -5.0f),
-		glm::vec3(0.0f, -10.0f, 15.0f)
-	};
-	for (int i = 0; i < 3; i++) {
-		scaleXYZ = glm::vec3(0.05f, 0.01f, 0.05f);
-		XrotationDegrees = crackerRotations[i].x;
-		YrotationDegrees = crackerRotations[i].y;
-		ZrotationDegrees = crackerRotations[i].z;
-		positionXYZ = crackerPositions[i];
-		SetTransformations(scaleXYZ, XrotationDegrees, YrotationDegrees, ZrotationDegrees, positionXYZ);
-		SetShaderMaterial("crackers");
-		m_basicMeshes->DrawCylinderMesh();
-	}
-
-
-	/**********************
-	 * Wine Glass Base
-	 **********************/
-
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.08f, 0.02f, 0.08f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.3f, 0.02f, -0.15f);
-
-	// set the transformations into memory to be used on the drawn meshes
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set shaders for next draw command
-	SetShaderColor(0.7f, 0.85f, 0.9f, 0.4f);
-	SetShaderMaterial("glass");
-	SetShaderTexture("glassTexture");
-	SetTextureUVScale(1.0f, 1.0f);
-
-	// draw cylinder mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	/**********************
-	 * Wine Glass Stem
-	 **********************/
-
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.03f, 0.15f, 0.03f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.3f, 0.05f, -0.15f);
-
-	// set the transformations for the mesh
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the shaders for the mesh
-	SetShaderColor(0.7f, 0.85f, 0.9f, 0.4f);
-	SetShaderMaterial("glass");
-
-	// draw cyclinder mesh
-	m_basicMeshes->DrawCylinderMesh();
-
-	/**********************
-	 * Wine Glass Cup
-	 **********************/
-
-	// set the XYZ scale for the mesh
-	scaleXYZ = glm::vec3(0.08f, 0.12f, 0.08f);
-
-	// set the XYZ rotation for the mesh
-	XrotationDegrees = 0.0f;
-	YrotationDegrees = 0.0f;
-	ZrotationDegrees = 0.0f;
-
-	// set the XYZ position for the mesh
-	positionXYZ = glm::vec3(0.3f, 0.2f, -0.15f);
-
-	// set the transformations for the mesh
-	SetTransformations(
-		scaleXYZ,
-		XrotationDegrees,
-		YrotationDegrees,
-		ZrotationDegrees,
-		positionXYZ);
-
-	// set the shaders for the mesh
-	SetShaderColor(0.7f, 0.85f, 0.9f, 0.4f);
-	SetShaderTexture("glassTexture2");
-	SetTextureUVScale(1.0f, 1.0f);
-	SetShaderMaterial("glass");
-
-	// draw cylinder mesh
-	m_basicMeshes->DrawCylinderMesh();
-}
-	
-
-
+///////////////////////////////////////////////////////////////////////////////
+// scenemanager.cpp
+// ============
+// manage the preparing and rendering of 3D scenes - textures, materials, lighting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "SceneManager.h"
+#include "GpuResourceTracker.h"
+#include "SceneLoader.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+#endif
+
+#include <glm/gtx/transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// declaration of global variables
+namespace
+{
+	// the layout of a DDS container header, following the
+	// four-byte "DDS " magic value
+	struct DDS_HEADER
+	{
+		uint32_t dwSize;
+		uint32_t dwFlags;
+		uint32_t dwHeight;
+		uint32_t dwWidth;
+		uint32_t dwPitchOrLinearSize;
+		uint32_t dwDepth;
+		uint32_t dwMipMapCount;
+		uint32_t dwReserved1[11];
+		struct
+		{
+			uint32_t dwSize;
+			uint32_t dwFlags;
+			uint32_t dwFourCC;
+			uint32_t dwRGBBitCount;
+			uint32_t dwRBitMask;
+			uint32_t dwGBitMask;
+			uint32_t dwBBitMask;
+			uint32_t dwABitMask;
+		} ddspf;
+		uint32_t dwCaps;
+		uint32_t dwCaps2;
+		uint32_t dwCaps3;
+		uint32_t dwCaps4;
+		uint32_t dwReserved2;
+	};
+
+	// the extended header that follows a "DX10" FourCC
+	struct DDS_HEADER_DXT10
+	{
+		uint32_t dxgiFormat;
+		uint32_t resourceDimension;
+		uint32_t miscFlag;
+		uint32_t arraySize;
+		uint32_t miscFlags2;
+	};
+
+	// builds a FourCC code from its four characters
+	uint32_t MakeFourCC(char c0, char c1, char c2, char c3)
+	{
+		return((uint32_t)c0 | ((uint32_t)c1 << 8) | ((uint32_t)c2 << 16) | ((uint32_t)c3 << 24));
+	}
+
+	// returns true when the passed in filename has a .dds extension
+	bool IsDDSFilename(const char* filename)
+	{
+		size_t length = strlen(filename);
+
+		if (length < 4)
+		{
+			return(false);
+		}
+
+		return((filename[length - 4] == '.') &&
+			(tolower(filename[length - 3]) == 'd') &&
+			(tolower(filename[length - 2]) == 'd') &&
+			(tolower(filename[length - 1]) == 's'));
+	}
+
+	// the editable scene description loaded by BuildSceneObjects()
+	const char* g_SceneFilename = "scenes/charcuterie.scene";
+
+	const char* g_ModelName = "model";
+	const char* g_ColorValueName = "objectColor";
+	const char* g_TextureValueName = "objectTexture";
+	const char* g_UseTextureName = "bUseTexture";
+	const char* g_UseLightingName = "bUseLighting";
+
+	// projected coverage thresholds driving the level-of-detail
+	// selection - below the first a curved shape is swapped for
+	// the box mesh, below the second the draw is skipped
+	const float g_CoverageLODThreshold = 0.02f;
+	const float g_CoverageDropThreshold = 0.0015f;
+
+	// size of one frame region in the instance streaming
+	// buffer - room for several thousand instance matrices
+	const size_t g_InstanceStreamRegionBytes = 512 * 1024;
+
+	// number of point light slots the fragment shader iterates
+	const int g_MaxShaderPointLights = 5;
+
+	// eviction hysteresis - a texture drawn within this many
+	// frames is never evicted, so a budget below the working
+	// set degrades to stale textures instead of an evict and
+	// reload thrash every frame
+	const long g_TextureEvictionIdleFrames = 60;
+
+	// texture images decoded ahead of time by the startup
+	// worker threads, adopted by CreateGLTextureAsync()
+	struct PREFETCHED_IMAGE
+	{
+		unsigned char* pImage;
+		int width;
+		int height;
+		int colorChannels;
+	};
+	std::mutex g_PrefetchMutex;
+	std::unordered_map<std::string, PREFETCHED_IMAGE> g_PrefetchedImages;
+}
+
+/***********************************************************
+ *  SceneManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+SceneManager::SceneManager(ShaderManager *pShaderManager)
+{
+	m_pShaderManager = pShaderManager;
+	m_basicMeshes = new ShapeMeshes();
+	m_bSceneBuilt = false;
+	m_buildUVScale = glm::vec2(1.0f);
+	m_buildColor = glm::vec4(1.0f);
+	m_bBuildUseTexture = false;
+	m_lastMaterialIndex = -1;
+	m_lastTextureSlot = -1;
+	m_lastUVScale = glm::vec2(0.0f);
+	m_lastColor = glm::vec4(0.0f);
+	m_lastUseTexture = -1;
+	m_bLastColorValid = false;
+	m_uniformCacheHits = 0;
+	m_uniformCacheMisses = 0;
+	m_bFrustumValid = false;
+	m_bBuildFrustumValid = false;
+	m_cameraPosition = glm::vec3(0.0f);
+	m_lastCulledCount = 0;
+	m_lodSubstitutedCount = 0;
+	m_lodDroppedCount = 0;
+	m_lastSubmittedMeshID = -1;
+	m_meshSwitchCount = 0;
+	m_bInstanceStreamTried = false;
+	m_bInstanceStreamEnabled = false;
+	m_bLightsDirty = false;
+	m_frameNumber = 0;
+	m_textureBudgetBytes = 0;
+	m_bFrameBuildRequested = false;
+	m_bFrameBuildDone = false;
+	m_bFrameBuildStop = false;
+	m_bFrameBuildPending = false;
+	m_sliceJobsTaken = 0;
+	m_sliceJobsDone = 0;
+	m_bSliceWorkersStop = false;
+	m_cameraVersion = 0;
+	m_frameBuildCameraVersion = -1;
+	m_lastViewProjection = glm::mat4(0.0f);
+	m_pendingTextureLoads = 0;
+}
+
+/***********************************************************
+ *  ~SceneManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+SceneManager::~SceneManager()
+{
+	// wait for an in-flight pipelined frame build, then stop
+	// and join the persistent build and slice workers before
+	// tearing the object down
+	WaitForFrameBuild();
+	{
+		std::lock_guard<std::mutex> lock(m_frameBuildMutex);
+		m_bFrameBuildStop = true;
+	}
+	m_frameBuildCondition.notify_all();
+	if (m_frameBuildThread.joinable())
+	{
+		m_frameBuildThread.join();
+	}
+	StopSliceWorkers();
+
+	// wait for any in-flight texture loader threads before
+	// tearing the object down
+	for (int i = 0; i < m_textureLoadThreads.size(); i++)
+	{
+		if (m_textureLoadThreads[i].joinable())
+		{
+			m_textureLoadThreads[i].join();
+		}
+	}
+
+	// report how much per-draw uniform traffic the shadowed
+	// state cache eliminated over the run
+	if ((m_uniformCacheHits + m_uniformCacheMisses) > 0)
+	{
+		std::cout << "INFO: uniform state cache - skipped:" << m_uniformCacheHits
+			<< " sent:" << m_uniformCacheMisses << std::endl;
+		std::cout << "INFO: mesh switches over the run:" << m_meshSwitchCount << std::endl;
+	}
+
+	// report the accounted GPU memory, then release the
+	// texture objects this instance created
+	GpuResourceTracker::PrintReport();
+	DestroyGLTextures();
+
+	m_pShaderManager = NULL;
+	delete m_basicMeshes;
+	m_basicMeshes = NULL;
+}
+
+/***********************************************************
+ *  CreateGLTexture()
+ *
+ *  This method is used for loading textures from image files,
+ *  configuring the texture mapping parameters in OpenGL,
+ *  generating the mipmaps, and loading the read texture into
+ *  the next available texture slot in memory.
+ ***********************************************************/
+bool SceneManager::CreateGLTexture(const char* filename, const std::string& tag)
+{
+	// block-compressed DDS containers bypass the stbi decode
+	// path entirely - a straight disk-to-GPU copy
+	if (IsDDSFilename(filename))
+	{
+		return(CreateGLTextureDDS(filename, tag));
+	}
+
+	int width = 0;
+	int height = 0;
+	int colorChannels = 0;
+	GLuint textureID = 0;
+
+	// indicate to always flip images vertically when loaded
+	stbi_set_flip_vertically_on_load(true);
+
+	// try to parse the image data from the specified image file
+	unsigned char* image = stbi_load(
+		filename,
+		&width,
+		&height,
+		&colorChannels,
+		0);
+
+	// if the image was successfully read from the image file
+	if (image)
+	{
+		std::cout << "Successfully loaded image:" << filename << ", width:" << width << ", height:" << height << ", channels:" << colorChannels << std::endl;
+
+		glGenTextures(1, &textureID);
+		glBindTexture(GL_TEXTURE_2D, textureID);
+
+		// set the texture wrapping parameters
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		// set texture filtering parameters
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		// if the loaded image is in RGB format
+		if (colorChannels == 3)
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image);
+		// if the loaded image is in RGBA format - it supports transparency
+		else if (colorChannels == 4)
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, image);
+		else
+		{
+			std::cout << "Not implemented to handle image with " << colorChannels << " channels" << std::endl;
+			return false;
+		}
+
+		// generate the texture mipmaps for mapping textures to lower resolutions
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		// free the image data from local memory
+		stbi_image_free(image);
+		glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+		// register the loaded texture and associate it with the special tag string
+		TEXTURE_INFO textureInfo;
+		textureInfo.ID = textureID;
+		textureInfo.tag = tag;
+		// the mip chain adds roughly a third on top
+		textureInfo.bytes = (uint32_t)(width * height * colorChannels * 4 / 3);
+		textureInfo.filename = filename;
+		textureInfo.lastDrawnFrame = 0;
+		textureInfo.bEvicted = false;
+		GpuResourceTracker::Add(GpuResourceTracker::CATEGORY_TEXTURE, textureInfo.bytes);
+		m_textureIndices[tag] = (int)m_textureIDs.size();
+		m_textureIDs.push_back(textureInfo);
+
+		return true;
+	}
+
+	std::cout << "Could not load image:" << filename << std::endl;
+
+	// Error loading the image
+	return false;
+}
+
+/***********************************************************
+ *  CreateGLTextureDDS()
+ *
+ *  This method is used for loading a block-compressed DDS
+ *  container (BC1/BC3/BC7) into OpenGL texture memory.  The
+ *  precomputed mip chain is uploaded level by level with
+ *  glCompressedTexImage2D, so there is no decode CPU cost,
+ *  no glGenerateMipmap pass, and roughly a quarter of the
+ *  VRAM of an uncompressed upload.
+ ***********************************************************/
+bool SceneManager::CreateGLTextureDDS(const char* filename, const std::string& tag)
+{
+	DDS_HEADER header;
+	uint32_t magicValue = 0;
+	GLenum format = 0;
+	uint32_t blockBytes = 0;
+	GLuint textureID = 0;
+
+	FILE* pFile = fopen(filename, "rb");
+	if (NULL == pFile)
+	{
+		std::cout << "Could not load image:" << filename << std::endl;
+		return false;
+	}
+
+	// validate the DDS magic value and header
+	if ((fread(&magicValue, sizeof(magicValue), 1, pFile) != 1) ||
+		(magicValue != MakeFourCC('D', 'D', 'S', ' ')) ||
+		(fread(&header, sizeof(header), 1, pFile) != 1) ||
+		(header.dwSize != 124))
+	{
+		std::cout << "Not a valid DDS file:" << filename << std::endl;
+		fclose(pFile);
+		return false;
+	}
+
+	// map the pixel format onto the matching GL block format
+	if (header.ddspf.dwFourCC == MakeFourCC('D', 'X', 'T', '1'))
+	{
+		format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+		blockBytes = 8;
+	}
+	else if (header.ddspf.dwFourCC == MakeFourCC('D', 'X', 'T', '5'))
+	{
+		format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+		blockBytes = 16;
+	}
+	else if (header.ddspf.dwFourCC == MakeFourCC('D', 'X', '1', '0'))
+	{
+		// the BC7 formats are described by the DX10 extended header
+		DDS_HEADER_DXT10 headerDX10;
+
+		if ((fread(&headerDX10, sizeof(headerDX10), 1, pFile) != 1) ||
+			((headerDX10.dxgiFormat != 98) && (headerDX10.dxgiFormat != 99)))
+		{
+			std::cout << "Not implemented to handle this DDS format:" << filename << std::endl;
+			fclose(pFile);
+			return false;
+		}
+
+		// DXGI_FORMAT_BC7_UNORM / DXGI_FORMAT_BC7_UNORM_SRGB
+		format = (headerDX10.dxgiFormat == 98) ?
+			GL_COMPRESSED_RGBA_BPTC_UNORM : GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM;
+		blockBytes = 16;
+	}
+	else
+	{
+		std::cout << "Not implemented to handle this DDS format:" << filename << std::endl;
+		fclose(pFile);
+		return false;
+	}
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters - the precomputed mip
+	// chain is used directly
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+		(header.dwMipMapCount > 1) ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	// upload every stored mip level straight from the file
+	uint32_t width = header.dwWidth;
+	uint32_t height = header.dwHeight;
+	uint32_t mipCount = (header.dwMipMapCount > 0) ? header.dwMipMapCount : 1;
+	uint32_t totalBytes = 0;
+	bool bUploadFailed = false;
+
+	for (uint32_t level = 0; (level < mipCount) && (false == bUploadFailed); level++)
+	{
+		uint32_t blocksWide = (width + 3) / 4;
+		uint32_t blocksHigh = (height + 3) / 4;
+		uint32_t levelBytes = blocksWide * blocksHigh * blockBytes;
+
+		unsigned char* pLevelData = new unsigned char[levelBytes];
+		if (fread(pLevelData, 1, levelBytes, pFile) != levelBytes)
+		{
+			std::cout << "Truncated DDS file:" << filename << std::endl;
+			bUploadFailed = true;
+		}
+		else
+		{
+			glCompressedTexImage2D(GL_TEXTURE_2D, level, format, width, height, 0, levelBytes, pLevelData);
+			totalBytes += levelBytes;
+		}
+		delete[] pLevelData;
+
+		width = (width > 1) ? (width / 2) : 1;
+		height = (height > 1) ? (height / 2) : 1;
+	}
+
+	fclose(pFile);
+	glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+	if (true == bUploadFailed)
+	{
+		glDeleteTextures(1, &textureID);
+		return false;
+	}
+
+	std::cout << "Successfully loaded image:" << filename << ", width:" << header.dwWidth << ", height:" << header.dwHeight << ", mips:" << mipCount << std::endl;
+
+	// register the loaded texture and associate it with the special tag string
+	TEXTURE_INFO textureInfo;
+	textureInfo.ID = textureID;
+	textureInfo.tag = tag;
+	textureInfo.bytes = totalBytes;
+	textureInfo.filename = filename;
+	textureInfo.lastDrawnFrame = 0;
+	textureInfo.bEvicted = false;
+	GpuResourceTracker::Add(GpuResourceTracker::CATEGORY_TEXTURE, textureInfo.bytes);
+	m_textureIndices[tag] = (int)m_textureIDs.size();
+	m_textureIDs.push_back(textureInfo);
+
+	return true;
+}
+
+/***********************************************************
+ *  CreateGLTextureAsync()
+ *
+ *  This method is used for starting an asynchronous texture
+ *  load.  A placeholder texture is created immediately so the
+ *  tag resolves to a stable slot and the scene can present
+ *  frames while the image decode runs on a worker thread -
+ *  the GL thread only performs the final upload.
+ ***********************************************************/
+bool SceneManager::CreateGLTextureAsync(const char* filename, const std::string& tag)
+{
+	GLuint textureID = 0;
+
+	// DDS containers need no decode work - load them directly
+	// instead of paying for a worker thread round trip
+	if (IsDDSFilename(filename))
+	{
+		return(CreateGLTextureDDS(filename, tag));
+	}
+
+	// create the texture object now with a 1x1 neutral gray
+	// placeholder - the decoded image is uploaded into this
+	// same object once the worker thread finishes
+	unsigned char placeholderPixel[4] = { 200, 200, 200, 255 };
+
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// set the texture wrapping parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	// set texture filtering parameters
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholderPixel);
+	glBindTexture(GL_TEXTURE_2D, 0); // Unbind the texture
+
+	// register the placeholder texture and associate it with
+	// the special tag string so lookups resolve immediately
+	TEXTURE_INFO textureInfo;
+	textureInfo.ID = textureID;
+	textureInfo.tag = tag;
+	// a 1x1 placeholder until the decoded image is uploaded
+	textureInfo.bytes = 4;
+	textureInfo.filename = filename;
+	textureInfo.lastDrawnFrame = 0;
+	textureInfo.bEvicted = false;
+	GpuResourceTracker::Add(GpuResourceTracker::CATEGORY_TEXTURE, textureInfo.bytes);
+	m_textureIndices[tag] = (int)m_textureIDs.size();
+	m_textureIDs.push_back(textureInfo);
+
+	m_pendingTextureLoads++;
+
+	// adopt a prefetched decode when a startup worker already
+	// produced this image - the upload happens on the next
+	// PollTextureLoads() with no decode work at all
+	{
+		std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+
+		std::unordered_map<std::string, PREFETCHED_IMAGE>::iterator prefetched =
+			g_PrefetchedImages.find(filename);
+		if (prefetched != g_PrefetchedImages.end())
+		{
+			TEXTURE_LOAD_RESULT result;
+
+			result.filename = filename;
+			result.tag = tag;
+			result.pImage = prefetched->second.pImage;
+			result.width = prefetched->second.width;
+			result.height = prefetched->second.height;
+			result.colorChannels = prefetched->second.colorChannels;
+			g_PrefetchedImages.erase(prefetched);
+
+			std::lock_guard<std::mutex> queueLock(m_textureLoadMutex);
+			m_readyTextureLoads.push(result);
+
+			return true;
+		}
+	}
+
+	// run the image decode on a worker thread - no GL calls
+	// are allowed off the GL thread, so only the stbi work
+	// happens here
+	std::string filenameCopy = filename;
+	m_textureLoadThreads.push_back(std::thread([this, filenameCopy, tag]()
+	{
+		TEXTURE_LOAD_RESULT result;
+
+		result.filename = filenameCopy;
+		result.tag = tag;
+		result.width = 0;
+		result.height = 0;
+		result.colorChannels = 0;
+
+		// indicate to always flip images vertically when loaded
+		stbi_set_flip_vertically_on_load(true);
+
+		// try to parse the image data from the specified image file
+		result.pImage = stbi_load(
+			filenameCopy.c_str(),
+			&result.width,
+			&result.height,
+			&result.colorChannels,
+			0);
+
+		// hand the decoded image to the GL thread for upload
+		std::lock_guard<std::mutex> lock(m_textureLoadMutex);
+		m_readyTextureLoads.push(result);
+	}));
+
+	return true;
+}
+
+/***********************************************************
+ *  PollTextureLoads()
+ *
+ *  This method is used for draining the queue of decoded
+ *  images and uploading them into their placeholder texture
+ *  objects.  It is called once per frame from RenderScene()
+ *  so frames keep presenting while loads stream in.
+ ***********************************************************/
+void SceneManager::PollTextureLoads()
+{
+	if (m_pendingTextureLoads == 0)
+	{
+		// every outstanding load has been consumed, so the
+		// loader threads have all finished - join and release
+		// them instead of letting the vector grow unbounded
+		// across reloads
+		if (m_textureLoadThreads.size() > 0)
+		{
+			for (int i = 0; i < m_textureLoadThreads.size(); i++)
+			{
+				if (m_textureLoadThreads[i].joinable())
+				{
+					m_textureLoadThreads[i].join();
+				}
+			}
+			m_textureLoadThreads.clear();
+		}
+		return;
+	}
+
+	while (true)
+	{
+		TEXTURE_LOAD_RESULT result;
+
+		// pull one finished decode off the ready queue
+		{
+			std::lock_guard<std::mutex> lock(m_textureLoadMutex);
+			if (m_readyTextureLoads.empty())
+			{
+				return;
+			}
+			result = m_readyTextureLoads.front();
+			m_readyTextureLoads.pop();
+		}
+
+		m_pendingTextureLoads--;
+
+		if (NULL == result.pImage)
+		{
+			std::cout << "Could not load image:" << result.filename << std::endl;
+			continue;
+		}
+
+		std::cout << "Successfully loaded image:" << result.filename << ", width:" << result.width << ", height:" << result.height << ", channels:" << result.colorChannels << std::endl;
+
+		int textureSlot = FindTextureSlot(result.tag);
+		if (textureSlot < 0)
+		{
+			stbi_image_free(result.pImage);
+			continue;
+		}
+
+		// upload into the placeholder texture object - draws
+		// bind on demand, so just invalidate the bind cache
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, m_textureIDs[textureSlot].ID);
+		m_lastTextureSlot = -1;
+
+		// if the loaded image is in RGB format
+		if (result.colorChannels == 3)
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB8, result.width, result.height, 0, GL_RGB, GL_UNSIGNED_BYTE, result.pImage);
+		// if the loaded image is in RGBA format - it supports transparency
+		else if (result.colorChannels == 4)
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, result.width, result.height, 0, GL_RGBA, GL_UNSIGNED_BYTE, result.pImage);
+		else
+			std::cout << "Not implemented to handle image with " << result.colorChannels << " channels" << std::endl;
+
+		// generate the texture mipmaps for mapping textures to lower resolutions
+		glGenerateMipmap(GL_TEXTURE_2D);
+
+		// swap the accounted bytes from the placeholder to the
+		// uploaded image plus its mip chain
+		GpuResourceTracker::Remove(GpuResourceTracker::CATEGORY_TEXTURE, m_textureIDs[textureSlot].bytes);
+		m_textureIDs[textureSlot].bytes =
+			(uint32_t)(result.width * result.height * result.colorChannels * 4 / 3);
+		m_textureIDs[textureSlot].bEvicted = false;
+		GpuResourceTracker::Add(GpuResourceTracker::CATEGORY_TEXTURE, m_textureIDs[textureSlot].bytes);
+
+		// free the image data from local memory
+		stbi_image_free(result.pImage);
+	}
+}
+
+/***********************************************************
+ *  BindGLTextures()
+ *
+ *  This method is used for preparing the texture bind state.
+ *  Textures are no longer parked one per texture unit - the
+ *  sorted draw list binds each texture on demand to unit
+ *  zero as it switches buckets, so the scene can reference
+ *  any number of textures.
+ ***********************************************************/
+void SceneManager::BindGLTextures()
+{
+	glActiveTexture(GL_TEXTURE0);
+}
+
+/***********************************************************
+ *  DestroyGLTextures()
+ *
+ *  This method is used for freeing all the loaded texture
+ *  objects and releasing their accounted GPU memory.
+ ***********************************************************/
+void SceneManager::DestroyGLTextures()
+{
+	for (int i = 0; i < (int)m_textureIDs.size(); i++)
+	{
+		glDeleteTextures(1, &m_textureIDs[i].ID);
+		GpuResourceTracker::Remove(GpuResourceTracker::CATEGORY_TEXTURE, m_textureIDs[i].bytes);
+	}
+
+	m_textureIDs.clear();
+	m_textureIndices.clear();
+}
+
+/***********************************************************
+ *  FindTextureID()
+ *
+ *  This method is used for getting an ID for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureID(const std::string& tag)
+{
+	int textureID = -1;
+
+	// resolve the tag through the registration-time registry
+	// instead of scanning the texture list
+	std::unordered_map<std::string, int>::const_iterator iter = m_textureIndices.find(tag);
+	if (iter != m_textureIndices.end())
+	{
+		textureID = m_textureIDs[iter->second].ID;
+	}
+
+	return(textureID);
+}
+
+/***********************************************************
+ *  FindTextureSlot()
+ *
+ *  This method is used for getting a slot index for the previously
+ *  loaded texture bitmap associated with the passed in tag.
+ ***********************************************************/
+int SceneManager::FindTextureSlot(const std::string& tag)
+{
+	int textureSlot = -1;
+
+	// resolve the tag through the registration-time registry
+	// instead of scanning the texture list
+	std::unordered_map<std::string, int>::const_iterator iter = m_textureIndices.find(tag);
+	if (iter != m_textureIndices.end())
+	{
+		textureSlot = iter->second;
+	}
+
+	return(textureSlot);
+}
+
+/***********************************************************
+ *  FindMaterial()
+ *
+ *  This method is used for getting a material from the previously
+ *  defined materials list that is associated with the passed in tag.
+ ***********************************************************/
+bool SceneManager::FindMaterial(const std::string& tag, OBJECT_MATERIAL& material)
+{
+	if (m_objectMaterials.size() == 0)
+	{
+		return(false);
+	}
+
+	// resolve the tag through the registration-time registry
+	// instead of scanning the material list
+	int index = FindMaterialIndex(tag);
+	if (index >= 0)
+	{
+		material.diffuseColor = m_objectMaterials[index].diffuseColor;
+		material.specularColor = m_objectMaterials[index].specularColor;
+		material.shininess = m_objectMaterials[index].shininess;
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  FindMaterialIndex()
+ *
+ *  This method is used for getting the integer handle for a
+ *  previously defined material associated with the passed in
+ *  tag.  Returns -1 when the tag is not registered.
+ ***********************************************************/
+int SceneManager::FindMaterialIndex(const std::string& tag)
+{
+	int materialIndex = -1;
+
+	std::unordered_map<std::string, int>::const_iterator iter = m_materialIndices.find(tag);
+	if (iter != m_materialIndices.end())
+	{
+		materialIndex = iter->second;
+	}
+
+	return(materialIndex);
+}
+
+/***********************************************************
+ *  AddObjectMaterial()
+ *
+ *  This method is used for registering a defined material
+ *  and its tag.  Returns the integer handle that the render
+ *  loop uses to index the material with no string lookups.
+ ***********************************************************/
+int SceneManager::AddObjectMaterial(const OBJECT_MATERIAL& material)
+{
+	int materialIndex = (int)m_objectMaterials.size();
+
+	m_objectMaterials.push_back(material);
+	m_materialIndices[material.tag] = materialIndex;
+
+	return(materialIndex);
+}
+
+/***********************************************************
+ *  SetTransformations()
+ *
+ *  This method is used for setting the transform buffer
+ *  using the passed in transformation values.
+ ***********************************************************/
+void SceneManager::SetTransformations(
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	// variables for this method
+	glm::mat4 modelView;
+	glm::mat4 scale;
+	glm::mat4 rotationX;
+	glm::mat4 rotationY;
+	glm::mat4 rotationZ;
+	glm::mat4 translation;
+
+	// set the scale value in the transform buffer
+	scale = glm::scale(scaleXYZ);
+	// set the rotation values in the transform buffer
+	rotationX = glm::rotate(glm::radians(XrotationDegrees), glm::vec3(1.0f, 0.0f, 0.0f));
+	rotationY = glm::rotate(glm::radians(YrotationDegrees), glm::vec3(0.0f, 1.0f, 0.0f));
+	rotationZ = glm::rotate(glm::radians(ZrotationDegrees), glm::vec3(0.0f, 0.0f, 1.0f));
+	// set the translation value in the transform buffer
+	translation = glm::translate(positionXYZ);
+
+	modelView = translation * rotationZ * rotationY * rotationX * scale;
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setMat4Value(g_ModelName, modelView);
+	}
+}
+
+/***********************************************************
+ *  ComposeModelMatrix()
+ *
+ *  This method is used for composing the cached model matrix
+ *  for a scene object from its authored transform values.
+ ***********************************************************/
+void SceneManager::ComposeModelMatrix(SCENE_OBJECT& object)
+{
+	// cache the composed matrix so the render loop does not
+	// need to recompute it every frame
+	object.modelMatrix = ComposeModelMatrix(
+		object.scaleXYZ,
+		glm::vec3(object.XrotationDegrees, object.YrotationDegrees, object.ZrotationDegrees),
+		object.positionXYZ);
+
+	// recompose the cached per-instance matrices for an
+	// instanced cluster record
+	for (int i = 0; i < object.instanceTransforms.size(); i++)
+	{
+		object.instanceModels[i] = ComposeModelMatrix(
+			object.instanceTransforms[i].scaleXYZ,
+			object.instanceTransforms[i].rotationDegreesXYZ,
+			object.instanceTransforms[i].positionXYZ);
+	}
+
+	object.bDirty = false;
+}
+
+/***********************************************************
+ *  ComposeModelMatrix()
+ *
+ *  This method is used for composing a model matrix from
+ *  the passed in transform values.  The result equals
+ *  translation * rotationZ * rotationY * rotationX * scale,
+ *  but the product is written out directly instead of
+ *  multiplying five 4x4 matrices, with fast paths for the
+ *  zero-rotation and Y-only cases that dominate the scene.
+ *  The build phase calls this from its parallel slices, so
+ *  every dirty matrix in a frame is recomposed in one pass.
+ ***********************************************************/
+glm::mat4 SceneManager::ComposeModelMatrix(
+	glm::vec3 scaleXYZ,
+	glm::vec3 rotationDegreesXYZ,
+	glm::vec3 positionXYZ)
+{
+	glm::mat4 model(1.0f);
+
+	// the translation goes straight into the last column
+	model[3] = glm::vec4(positionXYZ, 1.0f);
+
+	// fast path - no rotation at all, the scale lands on the
+	// matrix diagonal
+	if ((0.0f == rotationDegreesXYZ.x) &&
+		(0.0f == rotationDegreesXYZ.y) &&
+		(0.0f == rotationDegreesXYZ.z))
+	{
+		model[0][0] = scaleXYZ.x;
+		model[1][1] = scaleXYZ.y;
+		model[2][2] = scaleXYZ.z;
+
+		return(model);
+	}
+
+	// fast path - rotation about Y only, the common case for
+	// objects resting flat on the board
+	if ((0.0f == rotationDegreesXYZ.x) &&
+		(0.0f == rotationDegreesXYZ.z))
+	{
+		float cy = cosf(glm::radians(rotationDegreesXYZ.y));
+		float sy = sinf(glm::radians(rotationDegreesXYZ.y));
+
+		model[0] = glm::vec4(cy * scaleXYZ.x, 0.0f, -sy * scaleXYZ.x, 0.0f);
+		model[1] = glm::vec4(0.0f, scaleXYZ.y, 0.0f, 0.0f);
+		model[2] = glm::vec4(sy * scaleXYZ.z, 0.0f, cy * scaleXYZ.z, 0.0f);
+
+		return(model);
+	}
+
+	// general case - the columns of rotationZ * rotationY *
+	// rotationX written out once and scaled in place
+	float cx = cosf(glm::radians(rotationDegreesXYZ.x));
+	float sx = sinf(glm::radians(rotationDegreesXYZ.x));
+	float cy = cosf(glm::radians(rotationDegreesXYZ.y));
+	float sy = sinf(glm::radians(rotationDegreesXYZ.y));
+	float cz = cosf(glm::radians(rotationDegreesXYZ.z));
+	float sz = sinf(glm::radians(rotationDegreesXYZ.z));
+
+	model[0] = glm::vec4(
+		cz * cy * scaleXYZ.x,
+		sz * cy * scaleXYZ.x,
+		-sy * scaleXYZ.x,
+		0.0f);
+	model[1] = glm::vec4(
+		(cz * sy * sx - sz * cx) * scaleXYZ.y,
+		(sz * sy * sx + cz * cx) * scaleXYZ.y,
+		cy * sx * scaleXYZ.y,
+		0.0f);
+	model[2] = glm::vec4(
+		(cz * sy * cx + sz * sx) * scaleXYZ.z,
+		(sz * sy * cx - cz * sx) * scaleXYZ.z,
+		cy * cx * scaleXYZ.z,
+		0.0f);
+
+	return(model);
+}
+
+/***********************************************************
+ *  AddSceneObject()
+ *
+ *  This method is used for adding a single draw record into
+ *  the retained scene list.  The shading state active at the
+ *  time of the call - texture, UV scale, color - is resolved
+ *  and stored into the record so the render loop can replay
+ *  it without re-deriving any state.
+ ***********************************************************/
+int SceneManager::AddSceneObject(
+	MESH_ID meshID,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	SCENE_OBJECT object;
+
+	// store the mesh shape and authored transform values
+	object.meshID = meshID;
+	object.scaleXYZ = scaleXYZ;
+	object.XrotationDegrees = XrotationDegrees;
+	object.YrotationDegrees = YrotationDegrees;
+	object.ZrotationDegrees = ZrotationDegrees;
+	object.positionXYZ = positionXYZ;
+
+	// compose and cache the model matrix for the object
+	ComposeModelMatrix(object);
+
+	// snapshot the shading state that was authored before this
+	// call so the record is fully self-describing - the tags
+	// are resolved once here to the integer handles that the
+	// render loop indexes directly
+	object.materialTag = m_buildMaterialTag;
+	object.materialIndex = FindMaterialIndex(m_buildMaterialTag);
+	object.bUseTexture = m_bBuildUseTexture;
+	object.textureTag = m_buildTextureTag;
+	object.textureSlot = FindTextureSlot(m_buildTextureTag);
+	object.uvScale = m_buildUVScale;
+	object.color = m_buildColor;
+	object.instanceStreamOffset = -1;
+
+	m_sceneObjects.push_back(object);
+
+	return((int)m_sceneObjects.size() - 1);
+}
+
+/***********************************************************
+ *  AddInstancedSceneObjects()
+ *
+ *  This method is used for adding a cluster of same-mesh,
+ *  same-material instances into the retained scene list as
+ *  a single draw record.  The render loop sets the shading
+ *  state once for the whole cluster and then submits each
+ *  cached instance matrix, instead of paying a full state
+ *  round trip per instance.
+ ***********************************************************/
+int SceneManager::AddInstancedSceneObjects(
+	MESH_ID meshID,
+	int instanceCount,
+	const INSTANCE_TRANSFORM* pInstanceTransforms)
+{
+	SCENE_OBJECT object;
+
+	// store the mesh shape for the cluster - the record level
+	// transform is identity, each instance carries its own
+	object.meshID = meshID;
+	object.scaleXYZ = glm::vec3(1.0f);
+	object.XrotationDegrees = 0.0f;
+	object.YrotationDegrees = 0.0f;
+	object.ZrotationDegrees = 0.0f;
+	object.positionXYZ = glm::vec3(0.0f);
+	object.modelMatrix = glm::mat4(1.0f);
+	object.bDirty = false;
+
+	// store the authored per-instance transforms and compose
+	// the cached per-instance model matrices
+	for (int i = 0; i < instanceCount; i++)
+	{
+		object.instanceTransforms.push_back(pInstanceTransforms[i]);
+		object.instanceModels.push_back(ComposeModelMatrix(
+			pInstanceTransforms[i].scaleXYZ,
+			pInstanceTransforms[i].rotationDegreesXYZ,
+			pInstanceTransforms[i].positionXYZ));
+	}
+
+	// snapshot the shading state that was authored before this
+	// call so the record is fully self-describing - the tags
+	// are resolved once here to the integer handles that the
+	// render loop indexes directly
+	object.materialTag = m_buildMaterialTag;
+	object.materialIndex = FindMaterialIndex(m_buildMaterialTag);
+	object.bUseTexture = m_bBuildUseTexture;
+	object.textureTag = m_buildTextureTag;
+	object.textureSlot = FindTextureSlot(m_buildTextureTag);
+	object.uvScale = m_buildUVScale;
+	object.color = m_buildColor;
+
+	m_sceneObjects.push_back(object);
+
+	return((int)m_sceneObjects.size() - 1);
+}
+
+/***********************************************************
+ *  DrawSceneObjectMesh()
+ *
+ *  This method is used for drawing the passed in basic
+ *  mesh shape.
+ ***********************************************************/
+void SceneManager::DrawSceneObjectMesh(MESH_ID meshID)
+{
+	// each mesh switch rebinds a VAO/VBO inside ShapeMeshes -
+	// count them so the sorted replay order can be verified
+	if ((int)meshID != m_lastSubmittedMeshID)
+	{
+		m_lastSubmittedMeshID = (int)meshID;
+		m_meshSwitchCount++;
+	}
+
+	switch (meshID)
+	{
+	case MESH_PLANE:
+		m_basicMeshes->DrawPlaneMesh();
+		break;
+	case MESH_BOX:
+		m_basicMeshes->DrawBoxMesh();
+		break;
+	case MESH_SPHERE:
+		m_basicMeshes->DrawSphereMesh();
+		break;
+	case MESH_CYLINDER:
+		m_basicMeshes->DrawCylinderMesh();
+		break;
+	}
+}
+
+/***********************************************************
+ *  SetBuildColor()
+ *
+ *  This method is used for setting the authoring-time color
+ *  state that is captured into the next added scene object.
+ *  Like SetShaderColor(), setting a color turns texturing
+ *  off for the objects that follow.
+ ***********************************************************/
+void SceneManager::SetBuildColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	m_buildColor = glm::vec4(redColorValue, greenColorValue, blueColorValue, alphaValue);
+	m_bBuildUseTexture = false;
+}
+
+/***********************************************************
+ *  SetBuildTexture()
+ *
+ *  This method is used for setting the authoring-time texture
+ *  state that is captured into the next added scene object.
+ ***********************************************************/
+void SceneManager::SetBuildTexture(const std::string& textureTag)
+{
+	m_buildTextureTag = textureTag;
+	m_bBuildUseTexture = true;
+}
+
+/***********************************************************
+ *  SetBuildUVScale()
+ *
+ *  This method is used for setting the authoring-time texture
+ *  UV scale that is captured into the next added scene object.
+ ***********************************************************/
+void SceneManager::SetBuildUVScale(float u, float v)
+{
+	m_buildUVScale = glm::vec2(u, v);
+}
+
+/***********************************************************
+ *  SetBuildMaterial()
+ *
+ *  This method is used for setting the authoring-time material
+ *  tag that is captured into the next added scene object.
+ ***********************************************************/
+void SceneManager::SetBuildMaterial(const std::string& materialTag)
+{
+	m_buildMaterialTag = materialTag;
+}
+
+/***********************************************************
+ *  SetShaderColor()
+ *
+ *  This method is used for setting the passed in color
+ *  into the shader for the next draw command
+ ***********************************************************/
+void SceneManager::SetShaderColor(
+	float redColorValue,
+	float greenColorValue,
+	float blueColorValue,
+	float alphaValue)
+{
+	// variables for this method
+	glm::vec4 currentColor;
+
+	currentColor.r = redColorValue;
+	currentColor.g = greenColorValue;
+	currentColor.b = blueColorValue;
+	currentColor.a = alphaValue;
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, false);
+		m_pShaderManager->setVec4Value(g_ColorValueName, currentColor);
+	}
+}
+
+/***********************************************************
+ *  SetShaderTexture()
+ *
+ *  This method is used for setting the texture data
+ *  associated with the passed in ID into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderTexture(
+	const std::string& textureTag)
+{
+	// the tag stays the public veneer - it resolves to the
+	// registry index that the on-demand bind path uses
+	SetShaderTextureBySlot(FindTextureSlot(textureTag));
+}
+
+/***********************************************************
+ *  SetTextureUVScale()
+ *
+ *  This method is used for setting the texture UV scale
+ *  values into the shader.
+ ***********************************************************/
+void SceneManager::SetTextureUVScale(float u, float v)
+{
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setVec2Value("UVscale", glm::vec2(u, v));
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterial()
+ *
+ *  This method is used for passing the material values
+ *  into the shader.
+ ***********************************************************/
+void SceneManager::SetShaderMaterial(
+	const std::string& materialTag)
+{
+	if (m_objectMaterials.size() > 0)
+	{
+		OBJECT_MATERIAL material;
+		bool bReturn = false;
+
+		bReturn = FindMaterial(materialTag, material);
+		if (bReturn == true)
+		{
+			m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
+			m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
+			m_pShaderManager->setFloatValue("material.shininess", material.shininess);
+		}
+	}
+}
+
+/***********************************************************
+ *  SetShaderMaterialByIndex()
+ *
+ *  This method is used for passing the material values into
+ *  the shader by integer handle - a direct array index with
+ *  no string comparisons or allocations.
+ ***********************************************************/
+void SceneManager::SetShaderMaterialByIndex(int materialIndex)
+{
+	if ((materialIndex >= 0) && (materialIndex < m_objectMaterials.size()))
+	{
+		const OBJECT_MATERIAL& material = m_objectMaterials[materialIndex];
+
+		m_pShaderManager->setVec3Value("material.diffuseColor", material.diffuseColor);
+		m_pShaderManager->setVec3Value("material.specularColor", material.specularColor);
+		m_pShaderManager->setFloatValue("material.shininess", material.shininess);
+	}
+}
+
+/***********************************************************
+ *  SetShaderTextureBySlot()
+ *
+ *  This method is used for setting the texture slot into the
+ *  shader by integer handle - no tag lookup on the hot path.
+ ***********************************************************/
+void SceneManager::SetShaderTextureBySlot(int textureSlot)
+{
+	// bind the texture for this bucket on demand - the sampler
+	// always reads unit zero, so the registry can grow past
+	// any fixed texture unit count
+	if ((textureSlot >= 0) && (textureSlot < (int)m_textureIDs.size()))
+	{
+		glActiveTexture(GL_TEXTURE0);
+		glBindTexture(GL_TEXTURE_2D, m_textureIDs[textureSlot].ID);
+
+		// stamp the draw for the least-recently-drawn ranking
+		// and bring back an evicted texture a draw needs again
+		m_textureIDs[textureSlot].lastDrawnFrame = m_frameNumber;
+		if (true == m_textureIDs[textureSlot].bEvicted)
+		{
+			ReloadEvictedTexture(textureSlot);
+		}
+	}
+
+	if (NULL != m_pShaderManager)
+	{
+		m_pShaderManager->setIntValue(g_UseTextureName, true);
+		m_pShaderManager->setSampler2DValue(g_TextureValueName, 0);
+	}
+}
+
+/***********************************************************
+ *  LoadSceneTextures()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene
+ *  rendering
+ ***********************************************************/
+void SceneManager::LoadSceneTextures()
+{                
+	// the image decodes run on worker threads - each tag is
+	// immediately backed by a placeholder texture and the real
+	// images stream in while the scene is already rendering
+	CreateGLTextureAsync("textures/tableWood.jpg", "woodTexture");
+	CreateGLTextureAsync("textures/glassTop.jpg", "glassTexture");
+	CreateGLTextureAsync("textures/glassBottom.jpg", "glassTexture2");
+
+	// textures are bound on demand as the sorted draw list
+	// switches texture buckets - no up-front slot assignment
+	// and no limit on the number of scene textures
+
+	BindGLTextures();
+}
+
+ /***********************************************************
+  *  DefineObjectMaterials()
+  *
+  *  This method is used for configuring the various material
+  *  settings for all of the objects within the 3D scene.
+  ***********************************************************/
+void SceneManager::DefineObjectMaterials()
+{
+// Cheese
+	OBJECT_MATERIAL cheese;
+	cheese.tag = "cheese";
+	cheese.diffuseColor = glm::vec3(1.0f, 0.85f, 0.3f);
+	cheese.specularColor = glm::vec3(0.9f, 0.8f, 0.4f);
+	cheese.shininess = 32.0f;
+	AddObjectMaterial(cheese);
+
+	// Grapes
+	OBJECT_MATERIAL grapes;
+	grapes.tag = "grapes";
+	grapes.diffuseColor = glm::vec3(0.6f, 0.1f, 0.6f);
+	grapes.specularColor = glm::vec3(0.8f, 0.2f, 0.8f);
+	grapes.shininess = 32.0f;
+	AddObjectMaterial(grapes);
+
+	// Cherries
+	OBJECT_MATERIAL cherries;
+	cherries.tag = "cherries";
+	cherries.diffuseColor = glm::vec3(1.0f, 0.0f, 0.0f);
+	cherries.specularColor = glm::vec3(0.9f, 0.1f, 0.1f);
+	cherries.shininess = 32.0f;
+	AddObjectMaterial(cherries);
+
+	// Crackers
+	OBJECT_MATERIAL crackers;
+	crackers.tag = "crackers";
+	crackers.diffuseColor = glm::vec3(0.9f, 0.75f, 0.5f);
+	crackers.specularColor = glm::vec3(0.7f, 0.65f, 0.5f);
+	crackers.shininess = 8.0f;
+	AddObjectMaterial(crackers);
+
+	// Glass
+	OBJECT_MATERIAL glass;
+	glass.tag = "glass";
+	glass.diffuseColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	glass.specularColor = glm::vec3(1.0f, 1.0f, 1.0f);
+	glass.shininess = 500.0f;
+	AddObjectMaterial(glass);
+
+	// Wood
+	OBJECT_MATERIAL wood;
+	wood.tag = "wood";
+	wood.diffuseColor = glm::vec3(0.7f, 0.45f, 0.2f); 
+	wood.specularColor = glm::vec3(0.3f, 0.2f, 0.1f);
+	wood.shininess = 16.0f;
+	AddObjectMaterial(wood);
+}
+
+/***********************************************************
+ *  SetupSceneLights()
+ *
+ *  This method is called to add and configure the light
+ *  sources for the 3D scene.  There are up to 4 light sources.
+ ***********************************************************/
+void SceneManager::SetupSceneLights()
+{
+	SCENE_LIGHT accentLight;
+
+	m_pShaderManager->setBoolValue(g_UseLightingName, true);
+
+	// Directional Light - main sunlight
+	m_pShaderManager->setVec3Value("directionalLight.direction", glm::vec3(-0.5f, -1.0f, -0.3f)); 
+	m_pShaderManager->setVec3Value("directionalLight.ambient", glm::vec3(0.35f, 0.35f, 0.35f)); 
+	m_pShaderManager->setVec3Value("directionalLight.diffuse", glm::vec3(1.0f, 0.92f, 0.75f)); 
+	m_pShaderManager->setVec3Value("directionalLight.specular", glm::vec3(1.0f, 1.0f, 1.0f)); 
+	m_pShaderManager->setBoolValue("directionalLight.bActive", true);
+
+	// Point Light - soft colored accent, registered through
+	// the data-driven light list like any other light
+	accentLight.position = glm::vec3(0.25f, 0.25f, 0.15f);
+	accentLight.ambient = glm::vec3(0.05f, 0.02f, 0.03f);
+	accentLight.diffuse = glm::vec3(1.0f, 0.6f, 0.45f);
+	accentLight.specular = glm::vec3(1.0f, 0.7f, 0.5f);
+	AddPointLight(accentLight);
+}
+
+/***********************************************************
+ *  AddPointLight()
+ *
+ *  This method is used for registering a point light in the
+ *  data-driven light list.  Any number of lights can be
+ *  added - the upload pass selects the nearest ones for the
+ *  shader's fixed slots every frame, so a new light is one
+ *  call with no uniform plumbing.
+ ***********************************************************/
+int SceneManager::AddPointLight(const SCENE_LIGHT& light)
+{
+	m_pointLights.push_back(light);
+	m_bLightsDirty = true;
+
+	return((int)m_pointLights.size() - 1);
+}
+
+/***********************************************************
+ *  SetInstanceStreamingEnabled()
+ *
+ *  This method is used for enabling the per-frame instance
+ *  matrix staging into the streaming buffer.
+ ***********************************************************/
+void SceneManager::SetInstanceStreamingEnabled(bool bEnabled)
+{
+	m_bInstanceStreamEnabled = bEnabled;
+}
+
+/***********************************************************
+ *  SetTextureBudgetBytes()
+ *
+ *  This method is used for setting the optional soft texture
+ *  memory budget - a budget of zero disables enforcement.
+ ***********************************************************/
+void SceneManager::SetTextureBudgetBytes(size_t budgetBytes)
+{
+	m_textureBudgetBytes = budgetBytes;
+}
+
+/***********************************************************
+ *  EnforceTextureBudget()
+ *
+ *  This method is used for holding the accounted texture
+ *  memory under the soft budget.  While over budget, the
+ *  least recently drawn texture is shrunk to a 1x1
+ *  placeholder - it reloads from its source image the next
+ *  time a draw needs it, instead of the driver paging
+ *  everything at random.
+ ***********************************************************/
+void SceneManager::EnforceTextureBudget()
+{
+	if (0 == m_textureBudgetBytes)
+	{
+		return;
+	}
+
+	while (GpuResourceTracker::GetBytes(GpuResourceTracker::CATEGORY_TEXTURE) > m_textureBudgetBytes)
+	{
+		unsigned char placeholderPixel[4] = { 200, 200, 200, 255 };
+		int victimSlot = -1;
+
+		// pick the least recently drawn texture that still
+		// holds real image data and has sat idle past the
+		// hysteresis window - DDS textures stay resident since
+		// the reload path only decodes stbi formats
+		for (int i = 0; i < (int)m_textureIDs.size(); i++)
+		{
+			if ((false == m_textureIDs[i].bEvicted) &&
+				(false == IsDDSFilename(m_textureIDs[i].filename.c_str())) &&
+				(m_textureIDs[i].bytes > 4) &&
+				(m_textureIDs[i].lastDrawnFrame + g_TextureEvictionIdleFrames <= m_frameNumber) &&
+				((victimSlot < 0) ||
+				(m_textureIDs[i].lastDrawnFrame < m_textureIDs[victimSlot].lastDrawnFrame)))
+			{
+				victimSlot = i;
+			}
+		}
+		if (victimSlot < 0)
+		{
+			return;
+		}
+
+		TEXTURE_INFO& victim = m_textureIDs[victimSlot];
+
+		// replace the texture object with a fresh placeholder
+		// so the driver can actually release the mip chain
+		glDeleteTextures(1, &victim.ID);
+		glGenTextures(1, &victim.ID);
+		glBindTexture(GL_TEXTURE_2D, victim.ID);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, placeholderPixel);
+		glBindTexture(GL_TEXTURE_2D, 0);
+
+		GpuResourceTracker::Remove(GpuResourceTracker::CATEGORY_TEXTURE, victim.bytes - 4);
+		victim.bytes = 4;
+		victim.bEvicted = true;
+		// invalidate the bind cache in case the victim was the
+		// texture bound by the previous draw
+		m_lastTextureSlot = -1;
+
+		std::cout << "INFO: evicted texture over budget:" << victim.tag << std::endl;
+	}
+}
+
+/***********************************************************
+ *  ReloadEvictedTexture()
+ *
+ *  This method is used for reloading an evicted texture's
+ *  source image on a worker thread once a draw needs it
+ *  again - the placeholder shows until the upload lands.
+ ***********************************************************/
+void SceneManager::ReloadEvictedTexture(int textureSlot)
+{
+	TEXTURE_INFO& texture = m_textureIDs[textureSlot];
+
+	if (texture.filename.empty())
+	{
+		return;
+	}
+
+	// clear the flag now so the reload is only kicked once
+	texture.bEvicted = false;
+	m_pendingTextureLoads++;
+
+	std::string filenameCopy = texture.filename;
+	std::string tagCopy = texture.tag;
+	m_textureLoadThreads.push_back(std::thread([this, filenameCopy, tagCopy]()
+	{
+		TEXTURE_LOAD_RESULT result;
+
+		result.filename = filenameCopy;
+		result.tag = tagCopy;
+		result.width = 0;
+		result.height = 0;
+		result.colorChannels = 0;
+
+		// indicate to always flip images vertically when loaded
+		stbi_set_flip_vertically_on_load(true);
+
+		result.pImage = stbi_load(
+			filenameCopy.c_str(),
+			&result.width,
+			&result.height,
+			&result.colorChannels,
+			0);
+
+		// hand the decoded image to the GL thread for upload
+		std::lock_guard<std::mutex> lock(m_textureLoadMutex);
+		m_readyTextureLoads.push(result);
+	}));
+}
+
+/***********************************************************
+ *  UploadSceneLights()
+ *
+ *  This method is used for uploading the point lights that
+ *  matter most this frame into the shader's fixed slots.
+ *  The registered lights are ranked by distance to the
+ *  camera - a CPU stand-in for per-cluster light lists - and
+ *  nothing is uploaded while the winning selection and the
+ *  light values are unchanged.
+ ***********************************************************/
+void SceneManager::UploadSceneLights()
+{
+	char uniformName[40];
+	std::vector<int>& selectedSlots = m_selectedLightSlots;
+	std::vector<int>& lightOrder = m_lightOrderScratch;
+
+	if (NULL == m_pShaderManager)
+	{
+		return;
+	}
+
+	// rank the registered lights by squared camera distance -
+	// the scratch vectors keep their capacity across frames,
+	// so the ranking allocates nothing in the steady state
+	selectedSlots.clear();
+	lightOrder.clear();
+	for (int i = 0; i < m_pointLights.size(); i++)
+	{
+		lightOrder.push_back(i);
+	}
+	std::stable_sort(lightOrder.begin(), lightOrder.end(),
+		[this](int left, int right)
+	{
+		glm::vec3 toLeft = m_pointLights[left].position - m_cameraPosition;
+		glm::vec3 toRight = m_pointLights[right].position - m_cameraPosition;
+
+		return(glm::dot(toLeft, toLeft) < glm::dot(toRight, toRight));
+	});
+
+	for (int i = 0; (i < lightOrder.size()) && (i < g_MaxShaderPointLights); i++)
+	{
+		selectedSlots.push_back(lightOrder[i]);
+	}
+
+	// skip the whole upload while the selection is unchanged
+	if ((false == m_bLightsDirty) && (selectedSlots == m_lastLightSlots))
+	{
+		return;
+	}
+
+	for (int slot = 0; slot < g_MaxShaderPointLights; slot++)
+	{
+		if (slot < selectedSlots.size())
+		{
+			const SCENE_LIGHT& light = m_pointLights[selectedSlots[slot]];
+
+			snprintf(uniformName, sizeof(uniformName), "pointLights[%d].position", slot);
+			m_pShaderManager->setVec3Value(uniformName, light.position);
+			snprintf(uniformName, sizeof(uniformName), "pointLights[%d].ambient", slot);
+			m_pShaderManager->setVec3Value(uniformName, light.ambient);
+			snprintf(uniformName, sizeof(uniformName), "pointLights[%d].diffuse", slot);
+			m_pShaderManager->setVec3Value(uniformName, light.diffuse);
+			snprintf(uniformName, sizeof(uniformName), "pointLights[%d].specular", slot);
+			m_pShaderManager->setVec3Value(uniformName, light.specular);
+			snprintf(uniformName, sizeof(uniformName), "pointLights[%d].bActive", slot);
+			m_pShaderManager->setBoolValue(uniformName, true);
+		}
+		else
+		{
+			snprintf(uniformName, sizeof(uniformName), "pointLights[%d].bActive", slot);
+			m_pShaderManager->setBoolValue(uniformName, false);
+		}
+	}
+
+	m_lastLightSlots = selectedSlots;
+	m_bLightsDirty = false;
+}
+
+/***********************************************************
+ *  PrefetchTextureImage()
+ *
+ *  This method is used for decoding a texture image ahead
+ *  of time on a startup worker thread - pure stbi work with
+ *  no GL calls, so it runs concurrently with context
+ *  creation and shader compilation.
+ ***********************************************************/
+void SceneManager::PrefetchTextureImage(const char* filename)
+{
+	PREFETCHED_IMAGE image;
+
+	// indicate to always flip images vertically when loaded
+	stbi_set_flip_vertically_on_load(true);
+
+	image.pImage = stbi_load(filename,
+		&image.width, &image.height, &image.colorChannels, 0);
+	if (NULL == image.pImage)
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(g_PrefetchMutex);
+	g_PrefetchedImages[filename] = image;
+}
+
+/***********************************************************
+ *  PrepareScene()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene 
+ *  rendering
+ ***********************************************************/
+void SceneManager::PrepareScene()
+{
+	//define the materials for objects in the scene
+	DefineObjectMaterials();
+	//add and define the light sources for the scene
+	SetupSceneLights();
+	// load the textures for the 3D scene
+	LoadSceneTextures();
+
+	// only one instance of a particular mesh needs to be
+	// loaded in memory no matter how many times it is drawn
+	// in the rendered 3D scene
+
+	m_basicMeshes->LoadPlaneMesh();
+	m_basicMeshes->LoadCylinderMesh();
+	m_basicMeshes->LoadSphereMesh();
+	m_basicMeshes->LoadBoxMesh();
+
+	// build the retained scene object list once - RenderScene()
+	// replays these records every frame without re-deriving
+	// transforms or shading state
+	BuildSceneObjects();
+
+	// sort the records into submission order so draws sharing
+	// textures, materials and meshes run back-to-back
+	SortSceneObjects();
+}
+
+/***********************************************************
+ *  PrepareBenchmarkScene()
+ *
+ *  This method is used for preparing a synthetic 3D scene
+ *  for the benchmark harness in place of the authored one.
+ *  The passed in counts scale the workload - objects are
+ *  placed deterministically so runs are repeatable, cycling
+ *  through the meshes, the generated materials, and as many
+ *  loaded texture tags as requested.
+ ***********************************************************/
+void SceneManager::PrepareBenchmarkScene(
+	int objectCount,
+	int materialCount,
+	int textureCount)
+{
+	// a simple linear congruential sequence keeps the layout
+	// identical from run to run without pulling in <random>
+	uint32_t randomState = 12345;
+
+	// every object cycles through the materials with a modulo,
+	// so a zero or negative count would divide by zero
+	if (materialCount < 1)
+	{
+		materialCount = 1;
+	}
+	if (textureCount < 0)
+	{
+		textureCount = 0;
+	}
+
+	//add and define the light sources for the scene
+	SetupSceneLights();
+	// load the textures for the 3D scene
+	LoadSceneTextures();
+
+	m_basicMeshes->LoadPlaneMesh();
+	m_basicMeshes->LoadCylinderMesh();
+	m_basicMeshes->LoadSphereMesh();
+	m_basicMeshes->LoadBoxMesh();
+
+	// generate the requested number of synthetic materials
+	for (int i = 0; i < materialCount; i++)
+	{
+		OBJECT_MATERIAL material;
+		material.tag = "benchMaterial" + std::to_string(i);
+		material.diffuseColor = glm::vec3(
+			0.3f + 0.7f * (float)(i % 5) / 4.0f,
+			0.3f + 0.7f * (float)(i % 3) / 2.0f,
+			0.3f + 0.7f * (float)(i % 7) / 6.0f);
+		material.specularColor = glm::vec3(0.5f, 0.5f, 0.5f);
+		material.shininess = 8.0f + 32.0f * (float)(i % 8);
+		AddObjectMaterial(material);
+	}
+
+	// collect the loaded texture tags so textured objects can
+	// cycle through the requested number of them
+	std::vector<std::string> textureTags;
+	for (auto iterator = m_textureIndices.begin();
+		iterator != m_textureIndices.end(); iterator++)
+	{
+		textureTags.push_back(iterator->first);
+	}
+	if (textureCount > (int)textureTags.size())
+	{
+		textureCount = (int)textureTags.size();
+	}
+
+	// spread the objects through a box that grows with the
+	// object count so the density stays roughly constant
+	float spread = 2.0f + 0.05f * sqrtf((float)objectCount);
+
+	for (int i = 0; i < objectCount; i++)
+	{
+		glm::vec3 scaleXYZ;
+		glm::vec3 positionXYZ;
+		float rotationDegrees;
+		float randomValues[6];
+
+		for (int j = 0; j < 6; j++)
+		{
+			randomState = randomState * 1664525 + 1013904223;
+			randomValues[j] = (float)(randomState >> 8) / 16777216.0f;
+		}
+
+		SetBuildMaterial("benchMaterial" + std::to_string(i % materialCount));
+		if ((textureCount > 0) && ((i % 2) == 0))
+		{
+			SetBuildTexture(textureTags[i % textureCount]);
+			SetBuildUVScale(1.0, 1.0);
+		}
+		else
+		{
+			SetBuildColor(randomValues[3], randomValues[4], randomValues[5], 1.0f);
+		}
+
+		scaleXYZ = glm::vec3(0.05f + 0.25f * randomValues[3]);
+		rotationDegrees = 360.0f * randomValues[4];
+		positionXYZ = glm::vec3(
+			(randomValues[0] * 2.0f - 1.0f) * spread,
+			0.05f + randomValues[1] * 3.0f,
+			(randomValues[2] * 2.0f - 1.0f) * spread);
+
+		// cycle through the box, sphere and cylinder meshes
+		AddSceneObject(
+			(MESH_ID)(MESH_BOX + (i % 3)),
+			scaleXYZ,
+			0.0f, rotationDegrees, 0.0f,
+			positionXYZ);
+	}
+
+	// sort the records into submission order so draws sharing
+	// meshes, textures and materials run back-to-back
+	SortSceneObjects();
+	m_bSceneBuilt = true;
+
+	std::cout << "INFO: built benchmark scene - objects:" << objectCount
+		<< " materials:" << materialCount
+		<< " textures:" << textureCount << std::endl;
+}
+
+/***********************************************************
+ *  BuildSceneObjects()
+ *
+ *  This method is used for building the retained list of
+ *  scene object draw records.  It is called once from
+ *  PrepareScene() - the per-frame render loop just replays
+ *  the cached records.
+ ***********************************************************/
+void SceneManager::BuildSceneObjects()
+{
+	// prefer the editable scene file (or its binary fast-load
+	// cache) - the authored scene below remains the built-in
+	// fallback when no scene file is present
+	std::vector<SceneLoader::SCENE_RECORD> records;
+	if (SceneLoader::LoadSceneRecords(g_SceneFilename, records))
+	{
+		for (int i = 0; i < records.size(); i++)
+		{
+			const SceneLoader::SCENE_RECORD& record = records[i];
+
+			// restore the recorded shading state
+			if (record.bUseTexture)
+			{
+				SetBuildTexture(record.textureTag);
+				SetBuildUVScale(record.uvScale[0], record.uvScale[1]);
+			}
+			else
+			{
+				SetBuildColor(record.color[0], record.color[1], record.color[2], record.color[3]);
+			}
+			SetBuildMaterial(record.materialTag);
+
+			AddSceneObject(
+				(MESH_ID)record.meshID,
+				glm::vec3(record.scaleXYZ[0], record.scaleXYZ[1], record.scaleXYZ[2]),
+				record.rotationDegreesXYZ[0],
+				record.rotationDegreesXYZ[1],
+				record.rotationDegreesXYZ[2],
+				glm::vec3(record.positionXYZ[0], record.positionXYZ[1], record.positionXYZ[2]));
+		}
+
+		m_bSceneBuilt = true;
+		return;
+	}
+
+	// declare the variables for the transformations
+	glm::vec3 scaleXYZ;
+	float XrotationDegrees = 0.0f;
+	float YrotationDegrees = 0.0f;
+	float ZrotationDegrees = 0.0f;
+	glm::vec3 positionXYZ;
+
+	/*** Set needed transformations before adding the basic mesh.   ***/
+	/*** This same ordering of code should be used for transforming ***/
+	/*** and adding all the basic 3D shapes.						***/
+	/******************************************************************/
+
+	/**********************
+	 * Board
+	 **********************/
+
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.5f, 0.02f, 0.65f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.0f, 0.0f, 0.0f);
+
+	// set the texture for the draw record
+	SetBuildTexture("woodTexture");
+	SetBuildUVScale(1.0f, 1.0f);
+	SetBuildMaterial("wood");
+
+	// add the plane mesh draw record
+	AddSceneObject(
+		MESH_PLANE,
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	/**********************
+	 * Cheese Slices Cluster
+	 **********************/
+
+	// set the XYZ positions for the mesh
+	glm::vec3 cheesePositions[] = {
+		glm::vec3(0.2f, 0.02f, 0.15f),
+		glm::vec3(0.25f, 0.02f, 0.18f),
+		glm::vec3(0.28f, 0.02f, 0.12f)
+	};
+
+	// set the XYZ rotations for the mesh
+	glm::vec3 cheeseRotations[] = {
+		glm::vec3(0.0f, 0.0f, 5.0f),
+		glm::vec3(0.0f, 10.0f, 0.0f),
+		glm::vec3(0.0f, 15.0f, -5.0f)
+	};
+
+	// collect the cheese slices into a single instanced record x3
+	SetBuildMaterial("cheese");
+	INSTANCE_TRANSFORM cheeseInstances[3];
+	for (int i = 0; i < 3; i++) {
+		cheeseInstances[i].scaleXYZ = glm::vec3(0.1f, 0.01f, 0.05f);
+		cheeseInstances[i].rotationDegreesXYZ = cheeseRotations[i];
+		cheeseInstances[i].positionXYZ = cheesePositions[i];
+	}
+	AddInstancedSceneObjects(MESH_BOX, 3, cheeseInstances);
+
+	/**********************
+	 * Grapes Cluster
+	 **********************/
+
+	// set the positions for the mesh
+	glm::vec3 grapePositions[] = {
+		glm::vec3(0.0f, 0.03f, 0.2f),
+		glm::vec3(0.025f, 0.03f, 0.215f),
+		glm::vec3(-0.02f, 0.03f, 0.185f),
+		glm::vec3(0.015f, 0.03f, 0.18f)
+	};
+
+	// collect the grapes into a single instanced record x4
+	SetBuildMaterial("grapes");
+	INSTANCE_TRANSFORM grapeInstances[4];
+	for (int i = 0; i < 4; i++) {
+		grapeInstances[i].scaleXYZ = glm::vec3(0.02f);
+		grapeInstances[i].rotationDegreesXYZ = glm::vec3(0.0f);
+		grapeInstances[i].positionXYZ = grapePositions[i];
+	}
+	AddInstancedSceneObjects(MESH_SPHERE, 4, grapeInstances);
+
+	/**********************
+	 * Cherries Cluster
+	 **********************/
+
+	// set the positions for the mesh
+	glm::vec3 cherryPositions[] = {
+		glm::vec3(-0.1f, 0.03f, -0.05f),
+		glm::vec3(-0.08f, 0.03f, -0.07f),
+		glm::vec3(-0.115f, 0.03f, -0.045f)
+	};
+
+	// collect the cherries into a single instanced record x3
+	SetBuildMaterial("cherries");
+	INSTANCE_TRANSFORM cherryInstances[3];
+	for (int i = 0; i < 3; i++) {
+		cherryInstances[i].scaleXYZ = glm::vec3(0.02f);
+		cherryInstances[i].rotationDegreesXYZ = glm::vec3(0.0f);
+		cherryInstances[i].positionXYZ = cherryPositions[i];
+	}
+	AddInstancedSceneObjects(MESH_SPHERE, 3, cherryInstances);
+
+	/**********************
+	 * Crackers Cluster
+	 **********************/
+
+	// set the positions for the mesh
+	glm::vec3 crackerPositions[] = {
+		glm::vec3(-0.2f, 0.025f, 0.1f),
+		glm::vec3(-0.23f, 0.025f, 0.14f),
+		glm::vec3(-0.18f, 0.025f, 0.07f)
+	};
+
+	// set the rotations and shaders for each cracker x3
+	glm::vec3 crackerRotations[] = {
+		glm::vec3(0.0f, 0.0f, 10.0f),
+		glm::vec3(0.0f, 5.0f, -5.0f),
+		glm::vec3(0.0f, -10.0f, 15.0f)
+	};
+	// collect the crackers into a single instanced record x3
+	SetBuildMaterial("crackers");
+	INSTANCE_TRANSFORM crackerInstances[3];
+	for (int i = 0; i < 3; i++) {
+		crackerInstances[i].scaleXYZ = glm::vec3(0.05f, 0.01f, 0.05f);
+		crackerInstances[i].rotationDegreesXYZ = crackerRotations[i];
+		crackerInstances[i].positionXYZ = crackerPositions[i];
+	}
+	AddInstancedSceneObjects(MESH_CYLINDER, 3, crackerInstances);
+
+
+	/**********************
+	 * Wine Glass Base
+	 **********************/
+
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.08f, 0.02f, 0.08f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.3f, 0.02f, -0.15f);
+
+	// set shaders for the draw record
+	SetBuildColor(0.7f, 0.85f, 0.9f, 0.4f);
+	SetBuildMaterial("glass");
+	SetBuildTexture("glassTexture");
+	SetBuildUVScale(1.0f, 1.0f);
+
+	// add the cylinder mesh draw record
+	AddSceneObject(
+		MESH_CYLINDER,
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	/**********************
+	 * Wine Glass Stem
+	 **********************/
+
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.03f, 0.15f, 0.03f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.3f, 0.05f, -0.15f);
+
+	// set the shaders for the draw record - setting the color
+	// turns texturing back off for the stem
+	SetBuildColor(0.7f, 0.85f, 0.9f, 0.4f);
+	SetBuildMaterial("glass");
+
+	// add the cylinder mesh draw record
+	AddSceneObject(
+		MESH_CYLINDER,
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	/**********************
+	 * Wine Glass Cup
+	 **********************/
+
+	// set the XYZ scale for the mesh
+	scaleXYZ = glm::vec3(0.08f, 0.12f, 0.08f);
+
+	// set the XYZ rotation for the mesh
+	XrotationDegrees = 0.0f;
+	YrotationDegrees = 0.0f;
+	ZrotationDegrees = 0.0f;
+
+	// set the XYZ position for the mesh
+	positionXYZ = glm::vec3(0.3f, 0.2f, -0.15f);
+
+	// set the shaders for the draw record
+	SetBuildColor(0.7f, 0.85f, 0.9f, 0.4f);
+	SetBuildTexture("glassTexture2");
+	SetBuildUVScale(1.0f, 1.0f);
+	SetBuildMaterial("glass");
+
+	// add the cylinder mesh draw record
+	AddSceneObject(
+		MESH_CYLINDER,
+		scaleXYZ,
+		XrotationDegrees,
+		YrotationDegrees,
+		ZrotationDegrees,
+		positionXYZ);
+
+	// the retained scene list is now complete
+	m_bSceneBuilt = true;
+}
+
+/***********************************************************
+ *  SetObjectTransform()
+ *
+ *  This method is used for updating the authored transform
+ *  values for a retained scene object.  The cached model
+ *  matrix is not recomposed here - the object is flagged
+ *  dirty and recomputed once on the next frame, so static
+ *  objects never pay for matrix math.
+ ***********************************************************/
+void SceneManager::SetObjectTransform(
+	int objectIndex,
+	glm::vec3 scaleXYZ,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees,
+	glm::vec3 positionXYZ)
+{
+	if ((objectIndex < 0) || (objectIndex >= m_sceneObjects.size()))
+	{
+		return;
+	}
+
+	// the pipelined build reads the object records - never
+	// mutate them while it is in flight
+	WaitForFrameBuild();
+
+	SCENE_OBJECT& object = m_sceneObjects[objectIndex];
+
+	object.scaleXYZ = scaleXYZ;
+	object.XrotationDegrees = XrotationDegrees;
+	object.YrotationDegrees = YrotationDegrees;
+	object.ZrotationDegrees = ZrotationDegrees;
+	object.positionXYZ = positionXYZ;
+	JournalObjectChange(objectIndex);
+}
+
+/***********************************************************
+ *  SetObjectPosition()
+ *
+ *  This method is used for moving a single retained scene
+ *  object.  The change is journaled, so the next frame build
+ *  recomputes only this object's cached matrices - frame
+ *  cost scales with how much moved, not with scene size.
+ ***********************************************************/
+void SceneManager::SetObjectPosition(int objectIndex, glm::vec3 positionXYZ)
+{
+	if ((objectIndex < 0) || (objectIndex >= m_sceneObjects.size()))
+	{
+		return;
+	}
+
+	// the pipelined build reads the object records - never
+	// mutate them while it is in flight
+	WaitForFrameBuild();
+
+	m_sceneObjects[objectIndex].positionXYZ = positionXYZ;
+	JournalObjectChange(objectIndex);
+}
+
+/***********************************************************
+ *  SetObjectRotation()
+ *
+ *  This method is used for rotating a single retained scene
+ *  object.  The change is journaled, so the next frame build
+ *  recomputes only this object's cached matrices.
+ ***********************************************************/
+void SceneManager::SetObjectRotation(
+	int objectIndex,
+	float XrotationDegrees,
+	float YrotationDegrees,
+	float ZrotationDegrees)
+{
+	if ((objectIndex < 0) || (objectIndex >= m_sceneObjects.size()))
+	{
+		return;
+	}
+
+	// the pipelined build reads the object records - never
+	// mutate them while it is in flight
+	WaitForFrameBuild();
+
+	SCENE_OBJECT& object = m_sceneObjects[objectIndex];
+
+	object.XrotationDegrees = XrotationDegrees;
+	object.YrotationDegrees = YrotationDegrees;
+	object.ZrotationDegrees = ZrotationDegrees;
+	JournalObjectChange(objectIndex);
+}
+
+/***********************************************************
+ *  JournalObjectChange()
+ *
+ *  This method is used for appending an object to the change
+ *  journal - the dirty flag doubles as the deduplication
+ *  check, so an object mutated several times in one frame is
+ *  journaled once.
+ ***********************************************************/
+void SceneManager::JournalObjectChange(int objectIndex)
+{
+	if (false == m_sceneObjects[objectIndex].bDirty)
+	{
+		m_sceneObjects[objectIndex].bDirty = true;
+		m_changeJournal.push_back(objectIndex);
+	}
+}
+
+/***********************************************************
+ *  ProcessChangeJournal()
+ *
+ *  This method is used for applying the journaled object
+ *  changes at the start of a frame build.  Only the mutated
+ *  entries have their cached matrices recomputed, and the
+ *  scene is re-sorted only when a submission key actually
+ *  changed - a pure transform change keeps its bucket.
+ ***********************************************************/
+void SceneManager::ProcessChangeJournal()
+{
+	bool bResortNeeded = false;
+
+	for (int i = 0; i < m_changeJournal.size(); i++)
+	{
+		SCENE_OBJECT& object = m_sceneObjects[m_changeJournal[i]];
+		uint32_t newSortKey;
+
+		ComposeModelMatrix(object);
+
+		newSortKey = MakeSortKey(object);
+		if (newSortKey != object.sortKey)
+		{
+			object.sortKey = newSortKey;
+			bResortNeeded = true;
+		}
+	}
+	m_changeJournal.clear();
+
+	if (true == bResortNeeded)
+	{
+		SortSceneObjects();
+	}
+}
+
+/***********************************************************
+ *  SetObjectTransformDirty()
+ *
+ *  This method is used for flagging a retained scene object
+ *  so its cached model matrices are recomputed on the next
+ *  frame - for example after editing the instance transforms
+ *  of a cluster record in place.
+ ***********************************************************/
+void SceneManager::SetObjectTransformDirty(int objectIndex)
+{
+	if ((objectIndex >= 0) && (objectIndex < m_sceneObjects.size()))
+	{
+		// the pipelined build reads the object records - never
+		// mutate them while it is in flight
+		WaitForFrameBuild();
+		JournalObjectChange(objectIndex);
+	}
+}
+
+/***********************************************************
+ *  GetUniformCacheCounts()
+ *
+ *  This method is used for getting the hit/miss counts of
+ *  the shadowed uniform state cache.
+ ***********************************************************/
+void SceneManager::GetUniformCacheCounts(long& hits, long& misses) const
+{
+	hits = m_uniformCacheHits;
+	misses = m_uniformCacheMisses;
+}
+
+/***********************************************************
+ *  MakeSortKey()
+ *
+ *  This method is used for building the packed submission
+ *  sort key for a scene object.  From most to least
+ *  significant: a transparency bit (blended records stay
+ *  after all others), the mesh id, the texture slot, and the
+ *  material index.  Each mesh switch is a VAO/VBO rebind
+ *  inside ShapeMeshes - the most expensive state change in
+ *  the replay - so the key groups all draws that share a
+ *  mesh before the cheaper uniform-only changes.
+ ***********************************************************/
+uint32_t SceneManager::MakeSortKey(const SCENE_OBJECT& object) const
+{
+	uint32_t key = 0;
+
+	// untextured records with a translucent color go through
+	// the blend path and must draw after the opaque records
+	if ((false == object.bUseTexture) && (object.color.a < 1.0f))
+	{
+		key |= 0x80000000;
+	}
+
+	key |= ((uint32_t)object.meshID & 0x7F) << 24;
+	key |= ((uint32_t)(object.textureSlot + 1) & 0xFF) << 16;
+	key |= ((uint32_t)(object.materialIndex + 1) & 0xFF) << 8;
+
+	return(key);
+}
+
+/***********************************************************
+ *  SortSceneObjects()
+ *
+ *  This method is used for sorting the retained scene
+ *  objects into submission order.  The scene-authoring code
+ *  is unaffected - only the replay order changes, and the
+ *  sort is stable so records with equal keys keep their
+ *  authored order.
+ ***********************************************************/
+void SceneManager::SortSceneObjects()
+{
+	m_sortedObjectIndices.clear();
+
+	for (int i = 0; i < m_sceneObjects.size(); i++)
+	{
+		m_sceneObjects[i].sortKey = MakeSortKey(m_sceneObjects[i]);
+		m_sortedObjectIndices.push_back(i);
+	}
+
+	std::stable_sort(
+		m_sortedObjectIndices.begin(),
+		m_sortedObjectIndices.end(),
+		[this](int left, int right)
+		{
+			return(m_sceneObjects[left].sortKey < m_sceneObjects[right].sortKey);
+		});
+}
+
+/***********************************************************
+ *  SetFrameCamera()
+ *
+ *  This method is used for setting the camera state for the
+ *  next rendered frame.  The six view frustum planes are
+ *  extracted from the view*projection matrix so the render
+ *  loop can cull objects before submission.
+ ***********************************************************/
+void SceneManager::SetFrameCamera(
+	const glm::mat4& view,
+	const glm::mat4& projection,
+	glm::vec3 cameraPosition)
+{
+	glm::mat4 viewProjection = projection * view;
+
+	// an ahead-of-time frame build is only valid while the
+	// camera is unchanged - bump the version when it moves
+	if (viewProjection != m_lastViewProjection)
+	{
+		m_cameraVersion++;
+		m_lastViewProjection = viewProjection;
+	}
+
+	// extract the frustum planes from the combined matrix rows
+	// (Gribb/Hartmann) and normalize them so the plane
+	// distances can be compared against sphere radii
+	for (int i = 0; i < 6; i++)
+	{
+		int row = i / 2;
+		float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+		glm::vec4 plane;
+
+		plane.x = viewProjection[0][3] + sign * viewProjection[0][row];
+		plane.y = viewProjection[1][3] + sign * viewProjection[1][row];
+		plane.z = viewProjection[2][3] + sign * viewProjection[2][row];
+		plane.w = viewProjection[3][3] + sign * viewProjection[3][row];
+
+		float length = glm::length(glm::vec3(plane));
+		if (length > 0.0f)
+		{
+			plane /= length;
+		}
+
+		m_frustumPlanes[i] = plane;
+	}
+
+	m_cameraPosition = cameraPosition;
+	m_bFrustumValid = true;
+}
+
+/***********************************************************
+ *  GetMeshBoundingRadius()
+ *
+ *  This method is used for getting the bounding radius of a
+ *  unit-scaled basic mesh shape.  The radii are conservative
+ *  so a too-tight bound can never cull a visible object.
+ ***********************************************************/
+float SceneManager::GetMeshBoundingRadius(MESH_ID meshID) const
+{
+	switch (meshID)
+	{
+	case MESH_PLANE:
+		// the plane mesh spans two units on X and Z
+		return(1.5f);
+	case MESH_BOX:
+		// the box mesh is one unit per side, centered
+		return(0.9f);
+	case MESH_SPHERE:
+		return(1.1f);
+	case MESH_CYLINDER:
+		// the cylinder mesh grows upward from its base
+		return(1.6f);
+	}
+
+	return(2.0f);
+}
+
+/***********************************************************
+ *  SelectMeshLOD()
+ *
+ *  This method is used for picking the mesh to draw for one
+ *  object or instance from its projected screen coverage.
+ *  The coverage proxy is the scaled bounding radius over the
+ *  camera distance - far away spheres and cylinders are
+ *  swapped for the box mesh, whose vertex count is a small
+ *  fraction of theirs, and shapes below about a pixel of
+ *  coverage are dropped entirely.  Adjusting the tessellation
+ *  inside ShapeMeshes itself is not possible from here, so
+ *  mesh substitution stands in for true per-LOD index ranges.
+ ***********************************************************/
+SceneManager::MESH_ID SceneManager::SelectMeshLOD(
+	MESH_ID meshID,
+	glm::vec3 positionXYZ,
+	float maxScale,
+	bool& bDrawObject)
+{
+	bDrawObject = true;
+
+	// without a supplied camera everything draws at full detail
+	if (false == m_bFrustumValid)
+	{
+		return(meshID);
+	}
+
+	float distance = glm::length(positionXYZ - m_cameraPosition);
+	if (distance < 0.0001f)
+	{
+		return(meshID);
+	}
+
+	float coverage = (GetMeshBoundingRadius(meshID) * maxScale) / distance;
+
+	// the shape covers less than about a pixel - skip the draw
+	if (coverage < g_CoverageDropThreshold)
+	{
+		bDrawObject = false;
+		m_lodDroppedCount++;
+		return(meshID);
+	}
+
+	// far away curved shapes get the low vertex count stand-in
+	if ((coverage < g_CoverageLODThreshold) &&
+		((MESH_SPHERE == meshID) || (MESH_CYLINDER == meshID)))
+	{
+		m_lodSubstitutedCount++;
+		return(MESH_BOX);
+	}
+
+	return(meshID);
+}
+
+/***********************************************************
+ *  IsSphereVisible()
+ *
+ *  This method is used for testing a bounding sphere against
+ *  the current view frustum.
+ ***********************************************************/
+bool SceneManager::IsSphereVisible(glm::vec3 center, float radius) const
+{
+	for (int i = 0; i < 6; i++)
+	{
+		float distance =
+			m_buildFrustumPlanes[i].x * center.x +
+			m_buildFrustumPlanes[i].y * center.y +
+			m_buildFrustumPlanes[i].z * center.z +
+			m_buildFrustumPlanes[i].w;
+
+		if (distance < -radius)
+		{
+			return(false);
+		}
+	}
+
+	return(true);
+}
+
+/***********************************************************
+ *  IsObjectVisible()
+ *
+ *  This method is used for testing a retained scene object
+ *  against the current view frustum.  The bounding sphere is
+ *  derived from the mesh shape and the authored scale - for
+ *  a cluster record the whole record stays visible while any
+ *  of its instances is.
+ ***********************************************************/
+bool SceneManager::IsObjectVisible(const SCENE_OBJECT& object) const
+{
+	// without a supplied frustum everything is submitted
+	if (false == m_bBuildFrustumValid)
+	{
+		return(true);
+	}
+
+	float meshRadius = GetMeshBoundingRadius(object.meshID);
+
+	if (object.instanceTransforms.size() == 0)
+	{
+		float maxScale = glm::max(object.scaleXYZ.x,
+			glm::max(object.scaleXYZ.y, object.scaleXYZ.z));
+
+		return(IsSphereVisible(object.positionXYZ, meshRadius * maxScale));
+	}
+
+	for (int i = 0; i < object.instanceTransforms.size(); i++)
+	{
+		const INSTANCE_TRANSFORM& transform = object.instanceTransforms[i];
+		float maxScale = glm::max(transform.scaleXYZ.x,
+			glm::max(transform.scaleXYZ.y, transform.scaleXYZ.z));
+
+		if (IsSphereVisible(transform.positionXYZ, meshRadius * maxScale))
+		{
+			return(true);
+		}
+	}
+
+	return(false);
+}
+
+/***********************************************************
+ *  GetLastCulledCount()
+ *
+ *  This method is used for getting the number of objects
+ *  that were culled on the last rendered frame.
+ ***********************************************************/
+int SceneManager::GetLastCulledCount() const
+{
+	return(m_lastCulledCount);
+}
+
+/***********************************************************
+ *  GetLODCounts()
+ *
+ *  This method is used for getting the number of draws that
+ *  were swapped to a cheaper mesh or dropped for sub-pixel
+ *  coverage on the last rendered frame.
+ ***********************************************************/
+void SceneManager::GetLODCounts(int& substituted, int& dropped) const
+{
+	substituted = m_lodSubstitutedCount;
+	dropped = m_lodDroppedCount;
+}
+
+/***********************************************************
+ *  BuildCommandSlice()
+ *
+ *  This method is used for the per-slice work of the frame
+ *  build phase - recomposing dirty matrices and running the
+ *  frustum tests for a disjoint range of the sorted record
+ *  list, writing the surviving indices into the passed in
+ *  output list.  No GL calls are made here, so slices can
+ *  run on worker threads.
+ ***********************************************************/
+void SceneManager::BuildCommandSlice(
+	int firstIndex,
+	int lastIndex,
+	int* pVisibleIndices,
+	int& visibleCount)
+{
+	visibleCount = 0;
+
+	for (int i = firstIndex; i < lastIndex; i++)
+	{
+		SCENE_OBJECT& object = m_sceneObjects[m_sortedObjectIndices[i]];
+
+		// recompute the cached model matrices only when the
+		// object transform has been invalidated
+		if (true == object.bDirty)
+		{
+			ComposeModelMatrix(object);
+		}
+
+		if (IsObjectVisible(object))
+		{
+			pVisibleIndices[visibleCount] = m_sortedObjectIndices[i];
+			visibleCount++;
+		}
+	}
+}
+
+/***********************************************************
+ *  BuildFrameCommandList()
+ *
+ *  This method is used for building the visible command list
+ *  for the current frame.  Large scenes are split into
+ *  disjoint slices drained by the persistent worker pool -
+ *  the slices follow the sorted order, so concatenating the
+ *  per-worker lists preserves the submission order.  Small
+ *  scenes are processed inline, where waking the workers
+ *  would cost more than the work itself.
+ ***********************************************************/
+void SceneManager::BuildFrameCommandList(std::vector<int>& visibleIndices)
+{
+	// below this size waking the worker pool exceeds the
+	// transform and culling work
+	const int PARALLEL_THRESHOLD = 256;
+
+	int objectCount = (int)m_sortedObjectIndices.size();
+
+	// apply the journaled changes first - the build then only
+	// pays for the objects that actually moved this frame
+	ProcessChangeJournal();
+
+	visibleIndices.clear();
+
+	// all transient build data comes from the frame arena -
+	// a pointer bump per allocation, rewound here each frame
+	m_frameArena.Reset();
+
+	if (objectCount < PARALLEL_THRESHOLD)
+	{
+		int* pVisible = m_frameArena.AllocateArray<int>(objectCount);
+		int visibleCount = 0;
+
+		BuildCommandSlice(0, objectCount, pVisible, visibleCount);
+		visibleIndices.assign(pVisible, pVisible + visibleCount);
+		return;
+	}
+
+	// the persistent workers are created on first use and then
+	// parked between frames - per-frame thread creation would
+	// defeat the allocation-free steady state
+	if (m_sliceWorkers.empty())
+	{
+		StartSliceWorkers();
+	}
+
+	// split the sorted list into one contiguous slice per
+	// worker - the slices are disjoint, so the workers touch
+	// no shared state
+	int workerCount = (int)m_sliceWorkers.size();
+	int sliceSize = (objectCount + workerCount - 1) / workerCount;
+
+	// per-worker output arrays come straight from the arena
+	int** workerOutputs = m_frameArena.AllocateArray<int*>(workerCount);
+	int* workerCounts = m_frameArena.AllocateArray<int>(workerCount);
+
+	{
+		std::lock_guard<std::mutex> lock(m_sliceMutex);
+
+		// clear() keeps the vector capacity, so queueing the
+		// slices allocates nothing in the steady state
+		m_sliceJobs.clear();
+
+		for (int worker = 0; worker < workerCount; worker++)
+		{
+			int firstIndex = worker * sliceSize;
+			int lastIndex = firstIndex + sliceSize;
+
+			if (lastIndex > objectCount)
+			{
+				lastIndex = objectCount;
+			}
+
+			workerCounts[worker] = 0;
+			if (firstIndex >= lastIndex)
+			{
+				workerOutputs[worker] = NULL;
+				continue;
+			}
+
+			workerOutputs[worker] = m_frameArena.AllocateArray<int>(lastIndex - firstIndex);
+
+			SLICE_JOB job;
+			job.firstIndex = firstIndex;
+			job.lastIndex = lastIndex;
+			job.pVisibleIndices = workerOutputs[worker];
+			job.pVisibleCount = &workerCounts[worker];
+			m_sliceJobs.push_back(job);
+		}
+
+		m_sliceJobsTaken = 0;
+		m_sliceJobsDone = 0;
+	}
+	m_sliceWorkCondition.notify_all();
+
+	// wait for the parked workers to drain the queued slices
+	{
+		std::unique_lock<std::mutex> lock(m_sliceMutex);
+
+		m_sliceDoneCondition.wait(lock, [this]
+		{
+			return(m_sliceJobsDone == (int)m_sliceJobs.size());
+		});
+	}
+
+	// concatenate the per-worker lists - slice order matches
+	// the sorted submission order
+	for (int worker = 0; worker < workerCount; worker++)
+	{
+		if (NULL != workerOutputs[worker])
+		{
+			visibleIndices.insert(
+				visibleIndices.end(),
+				workerOutputs[worker],
+				workerOutputs[worker] + workerCounts[worker]);
+		}
+	}
+}
+
+/***********************************************************
+ *  StartSliceWorkers()
+ *
+ *  This method is used for creating the persistent slice
+ *  workers - one per hardware thread, capped at sixteen.
+ ***********************************************************/
+void SceneManager::StartSliceWorkers()
+{
+	int workerCount = (int)std::thread::hardware_concurrency();
+
+	if (workerCount < 1)
+	{
+		workerCount = 1;
+	}
+	if (workerCount > 16)
+	{
+		workerCount = 16;
+	}
+
+	m_bSliceWorkersStop = false;
+	for (int i = 0; i < workerCount; i++)
+	{
+		m_sliceWorkers.push_back(std::thread(&SceneManager::SliceWorkerLoop, this));
+	}
+}
+
+/***********************************************************
+ *  StopSliceWorkers()
+ *
+ *  This method is used for waking, stopping and joining the
+ *  persistent slice workers.
+ ***********************************************************/
+void SceneManager::StopSliceWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_sliceMutex);
+		m_bSliceWorkersStop = true;
+	}
+	m_sliceWorkCondition.notify_all();
+
+	for (int i = 0; i < m_sliceWorkers.size(); i++)
+	{
+		if (m_sliceWorkers[i].joinable())
+		{
+			m_sliceWorkers[i].join();
+		}
+	}
+	m_sliceWorkers.clear();
+}
+
+/***********************************************************
+ *  SliceWorkerLoop()
+ *
+ *  This method is the persistent slice worker loop - each
+ *  worker claims queued slices until the queue drains, then
+ *  parks on the condition variable until the next frame
+ *  build queues more.
+ ***********************************************************/
+void SceneManager::SliceWorkerLoop()
+{
+	while (true)
+	{
+		SLICE_JOB job;
+
+		{
+			std::unique_lock<std::mutex> lock(m_sliceMutex);
+
+			m_sliceWorkCondition.wait(lock, [this]
+			{
+				return((m_sliceJobsTaken < (int)m_sliceJobs.size()) || m_bSliceWorkersStop);
+			});
+
+			if (true == m_bSliceWorkersStop)
+			{
+				return;
+			}
+
+			job = m_sliceJobs[m_sliceJobsTaken];
+			m_sliceJobsTaken++;
+		}
+
+		BuildCommandSlice(
+			job.firstIndex, job.lastIndex,
+			job.pVisibleIndices, *job.pVisibleCount);
+
+		{
+			std::lock_guard<std::mutex> lock(m_sliceMutex);
+
+			m_sliceJobsDone++;
+			if (m_sliceJobsDone == (int)m_sliceJobs.size())
+			{
+				m_sliceDoneCondition.notify_one();
+			}
+		}
+	}
+}
+
+/***********************************************************
+ *  SnapshotBuildCamera()
+ *
+ *  This method is used for copying the live frustum into the
+ *  build snapshot.  SetFrameCamera() writes the live planes
+ *  from the render thread each frame/view, while an
+ *  ahead-of-time build may still be running on the build
+ *  worker - the workers only ever read the snapshot, taken
+ *  here on the render thread before a build starts.
+ ***********************************************************/
+void SceneManager::SnapshotBuildCamera()
+{
+	for (int i = 0; i < 6; i++)
+	{
+		m_buildFrustumPlanes[i] = m_frustumPlanes[i];
+	}
+	m_bBuildFrustumValid = m_bFrustumValid;
+}
+
+/***********************************************************
+ *  FrameBuildWorkerLoop()
+ *
+ *  This method is the persistent frame-build worker loop -
+ *  it parks on the condition variable between frames and
+ *  builds the next frame's command list when woken, so the
+ *  pipelined build creates no threads on the hot path.
+ ***********************************************************/
+void SceneManager::FrameBuildWorkerLoop()
+{
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_frameBuildMutex);
+
+			m_frameBuildCondition.wait(lock, [this]
+			{
+				return(m_bFrameBuildRequested || m_bFrameBuildStop);
+			});
+
+			if (true == m_bFrameBuildStop)
+			{
+				return;
+			}
+			m_bFrameBuildRequested = false;
+		}
+
+		BuildFrameCommandList(m_nextVisibleObjectIndices);
+
+		{
+			std::lock_guard<std::mutex> lock(m_frameBuildMutex);
+			m_bFrameBuildDone = true;
+		}
+		m_frameBuildCondition.notify_all();
+	}
+}
+
+/***********************************************************
+ *  StartAsyncFrameBuild()
+ *
+ *  This method is used for starting the build of the next
+ *  frame's command list on the persistent build worker.  It
+ *  runs while the GPU consumes the commands just submitted
+ *  and the buffers swap, so the CPU build cost of frame N+1
+ *  hides behind the GPU cost of frame N.
+ ***********************************************************/
+void SceneManager::StartAsyncFrameBuild()
+{
+	m_frameBuildCameraVersion = m_cameraVersion;
+	m_bFrameBuildPending = true;
+	SnapshotBuildCamera();
+
+	// the worker is created once and then reused - a fresh
+	// thread per frame would be a heap allocation and a
+	// syscall on the hot path
+	if (false == m_frameBuildThread.joinable())
+	{
+		m_frameBuildThread = std::thread(&SceneManager::FrameBuildWorkerLoop, this);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_frameBuildMutex);
+		m_bFrameBuildRequested = true;
+		m_bFrameBuildDone = false;
+	}
+	m_frameBuildCondition.notify_one();
+}
+
+/***********************************************************
+ *  WaitForFrameBuild()
+ *
+ *  This method is used for waiting on an in-flight pipelined
+ *  frame build.
+ ***********************************************************/
+void SceneManager::WaitForFrameBuild()
+{
+	if (true == m_bFrameBuildPending)
+	{
+		std::unique_lock<std::mutex> lock(m_frameBuildMutex);
+
+		m_frameBuildCondition.wait(lock, [this]
+		{
+			return(m_bFrameBuildDone);
+		});
+		m_bFrameBuildPending = false;
+	}
+}
+
+/***********************************************************
+ *  RenderScene()
+ *
+ *  This method is used for rendering the 3D scene by
+ *  replaying the retained scene object records.  Uniform
+ *  values are only re-uploaded when they differ from the
+ *  previous draw, so a static scene renders with near-zero
+ *  CPU work per frame.
+ ***********************************************************/
+void SceneManager::RenderScene()
+{
+	m_frameNumber++;
+
+	// upload any texture images that finished decoding on the
+	// loader threads since the previous frame
+	PollTextureLoads();
+
+	// hold the accounted texture memory under the soft budget
+	EnforceTextureBudget();
+
+	if (false == m_bSceneBuilt)
+	{
+		return;
+	}
+
+	// consume the command list built ahead during the previous
+	// frame when the camera has not moved since - otherwise
+	// build this frame's list now
+	if (true == m_bFrameBuildPending)
+	{
+		WaitForFrameBuild();
+		if (m_frameBuildCameraVersion == m_cameraVersion)
+		{
+			m_visibleObjectIndices.swap(m_nextVisibleObjectIndices);
+		}
+		else
+		{
+			SnapshotBuildCamera();
+			BuildFrameCommandList(m_visibleObjectIndices);
+		}
+	}
+	else
+	{
+		SnapshotBuildCamera();
+		BuildFrameCommandList(m_visibleObjectIndices);
+	}
+	m_lastCulledCount = (int)m_sortedObjectIndices.size() - (int)m_visibleObjectIndices.size();
+
+	// upload the point lights that matter for this camera
+	// position - a no-op while the selection is unchanged
+	UploadSceneLights();
+
+	// stage this frame's instance matrices straight into the
+	// persistently mapped streaming buffer - a memcpy into
+	// GPU-visible memory with no driver copies.  Off by
+	// default: the staged matrices have no consumer until an
+	// instanced-attribute draw path exists, so the per-frame
+	// copies would be pure overhead
+	if ((true == m_bInstanceStreamEnabled) && (false == m_bInstanceStreamTried))
+	{
+		m_instanceStreamBuffer.Create(GL_ARRAY_BUFFER, g_InstanceStreamRegionBytes);
+		m_bInstanceStreamTried = true;
+	}
+	if (true == m_instanceStreamBuffer.IsCreated())
+	{
+		m_instanceStreamBuffer.BeginFrame();
+		for (int i = 0; i < m_visibleObjectIndices.size(); i++)
+		{
+			SCENE_OBJECT& object = m_sceneObjects[m_visibleObjectIndices[i]];
+
+			if (object.instanceModels.size() > 0)
+			{
+				object.instanceStreamOffset = m_instanceStreamBuffer.Write(
+					object.instanceModels.data(),
+					object.instanceModels.size() * sizeof(glm::mat4));
+			}
+		}
+	}
+
+	// the sorted list puts every transparent record after the
+	// opaque ones - find the phase boundary
+	int opaqueCount = (int)m_visibleObjectIndices.size();
+	while ((opaqueCount > 0) &&
+		((m_sceneObjects[m_visibleObjectIndices[opaqueCount - 1]].sortKey & 0x80000000) != 0))
+	{
+		opaqueCount--;
+	}
+
+	m_lodSubstitutedCount = 0;
+	m_lodDroppedCount = 0;
+
+	// opaque phase - blending off and depth writes on, so the
+	// bulk of the scene keeps early-z rejection
+	glDisable(GL_BLEND);
+	glDepthMask(GL_TRUE);
+	for (int i = 0; i < opaqueCount; i++)
+	{
+		SubmitSceneObject(m_sceneObjects[m_visibleObjectIndices[i]]);
+	}
+
+	// transparent phase - sorted back-to-front by camera
+	// distance every frame so the glass composites correctly
+	// from any angle, with depth writes off so it never
+	// occludes anything behind it
+	if (opaqueCount < m_visibleObjectIndices.size())
+	{
+		m_transparentDrawOrder.assign(
+			m_visibleObjectIndices.begin() + opaqueCount,
+			m_visibleObjectIndices.end());
+		std::sort(m_transparentDrawOrder.begin(), m_transparentDrawOrder.end(),
+			[this](int left, int right)
+		{
+			glm::vec3 toLeft = m_sceneObjects[left].positionXYZ - m_cameraPosition;
+			glm::vec3 toRight = m_sceneObjects[right].positionXYZ - m_cameraPosition;
+
+			return(glm::dot(toLeft, toLeft) > glm::dot(toRight, toRight));
+		});
+
+		glEnable(GL_BLEND);
+		glDepthMask(GL_FALSE);
+		for (int i = 0; i < m_transparentDrawOrder.size(); i++)
+		{
+			SubmitSceneObject(m_sceneObjects[m_transparentDrawOrder[i]]);
+		}
+		glDepthMask(GL_TRUE);
+		glDisable(GL_BLEND);
+	}
+
+	// fence the streamed region once the frame's draws have
+	// been issued, then advance the ring
+	if (true == m_instanceStreamBuffer.IsCreated())
+	{
+		m_instanceStreamBuffer.EndFrame();
+	}
+
+	// start building the next frame's command list while the
+	// GPU consumes this one
+	StartAsyncFrameBuild();
+}
+
+/***********************************************************
+ *  SubmitSceneObject()
+ *
+ *  This method is used for replaying a single retained draw
+ *  record.  The shading state is set once for the record -
+ *  for an instanced cluster each cached instance matrix is
+ *  then submitted with no further state changes.
+ ***********************************************************/
+void SceneManager::SubmitSceneObject(SCENE_OBJECT& object)
+{
+	// recompute the cached model matrices only when the
+	// object transform has been invalidated
+	if (true == object.bDirty)
+	{
+		ComposeModelMatrix(object);
+	}
+
+	// pick the level of detail for a single object before any
+	// state is set - a dropped object costs nothing at all
+	bool bDrawObject = true;
+	MESH_ID lodMeshID = object.meshID;
+
+	if (object.instanceModels.size() == 0)
+	{
+		float maxScale = glm::max(object.scaleXYZ.x,
+			glm::max(object.scaleXYZ.y, object.scaleXYZ.z));
+
+		lodMeshID = SelectMeshLOD(
+			object.meshID, object.positionXYZ, maxScale, bDrawObject);
+		if (false == bDrawObject)
+		{
+			return;
+		}
+	}
+
+	if (true == object.bUseTexture)
+	{
+		// only rebind the texture when it differs from the
+		// previous draw
+		if (m_lastUseTexture != 1 ||
+			object.textureSlot != m_lastTextureSlot)
+		{
+			SetShaderTextureBySlot(object.textureSlot);
+			m_lastTextureSlot = object.textureSlot;
+			m_lastUseTexture = 1;
+			m_uniformCacheMisses++;
+		}
+		else
+		{
+			m_uniformCacheHits++;
+		}
+		// only re-upload the UV scale when it has changed
+		if (object.uvScale != m_lastUVScale)
+		{
+			SetTextureUVScale(object.uvScale.x, object.uvScale.y);
+			m_lastUVScale = object.uvScale;
+			m_uniformCacheMisses++;
+		}
+		else
+		{
+			m_uniformCacheHits++;
+		}
+	}
+	else
+	{
+		// only re-upload the color when the previous draw
+		// was textured or used a different color
+		if (m_lastUseTexture != 0 ||
+			false == m_bLastColorValid ||
+			object.color != m_lastColor)
+		{
+			SetShaderColor(object.color.r, object.color.g, object.color.b, object.color.a);
+			m_lastColor = object.color;
+			m_bLastColorValid = true;
+			m_lastUseTexture = 0;
+			m_uniformCacheMisses++;
+		}
+		else
+		{
+			m_uniformCacheHits++;
+		}
+	}
+
+	// only re-upload the material values when the material
+	// differs from the previous draw
+	if (object.materialIndex != m_lastMaterialIndex)
+	{
+		SetShaderMaterialByIndex(object.materialIndex);
+		m_lastMaterialIndex = object.materialIndex;
+		m_uniformCacheMisses++;
+	}
+	else
+	{
+		m_uniformCacheHits++;
+	}
+
+	if (NULL == m_pShaderManager)
+	{
+		return;
+	}
+
+	if (object.instanceModels.size() == 0)
+	{
+		// upload the cached model matrix for the object
+		m_pShaderManager->setMat4Value(g_ModelName, object.modelMatrix);
+
+		// draw the selected mesh shape for the object
+		DrawSceneObjectMesh(lodMeshID);
+	}
+	else
+	{
+		// submit every instance in the cluster - only the model
+		// matrix changes between the draws, and each instance
+		// picks its own level of detail from its own distance
+		for (int i = 0; i < object.instanceModels.size(); i++)
+		{
+			const INSTANCE_TRANSFORM& transform = object.instanceTransforms[i];
+			float maxScale = glm::max(transform.scaleXYZ.x,
+				glm::max(transform.scaleXYZ.y, transform.scaleXYZ.z));
+
+			lodMeshID = SelectMeshLOD(
+				object.meshID, transform.positionXYZ, maxScale, bDrawObject);
+			if (false == bDrawObject)
+			{
+				continue;
+			}
+
+			m_pShaderManager->setMat4Value(g_ModelName, object.instanceModels[i]);
+			DrawSceneObjectMesh(lodMeshID);
+		}
+	}
+}
@@ -1,112 +1,577 @@
-///////////////////////////////////////////////////////////////////////////////
-// scenemanager.h
-// ============
-// manage the preparing and rendering of 3D scenes - textures, materials, lighting
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#pragma once
-
-#include "ShaderManager.h"
-#include "ShapeMeshes.h"
-
-#include <string>
-#include <vector>
-
-/***********************************************************
- *  SceneManager
- *
- *  This class contains the code for preparing and rendering
- *  3D scenes, including the shader settings.
- ***********************************************************/
-class SceneManager
-{
-public:
-	// constructor
-	SceneManager(ShaderManager *pShaderManager);
-	// destructor
-	~SceneManager();
-
-	struct TEXTURE_INFO
-	{
-		std::string tag;
-		uint32_t ID;
-	};
-
-	struct OBJECT_MATERIAL
-	{
-		glm::vec3 diffuseColor;
-		glm::vec3 specularColor;
-		float shininess;
-		std::string tag;
-	};
-
-private:
-	// pointer to shader manager object
-	ShaderManager* m_pShaderManager;
-	// pointer to basic shapes object
-	ShapeMeshes* m_basicMeshes;
-	// total number of loaded textures
-	int m_loadedTextures;
-	// loaded textures info
-	TEXTURE_INFO m_textureIDs[16];
-	// defined object materials
-	std::vector<OBJECT_MATERIAL> m_objectMaterials;
-
-	// load texture images and convert to OpenGL texture data
-	bool CreateGLTexture(const char* filename, std::string tag);
-	// bind loaded OpenGL textures to slots in memory
-	void BindGLTextures();
-	// free the loaded OpenGL textures
-	void DestroyGLTextures();
-	// find a loaded texture by tag
-	int FindTextureID(std::string tag);
-	int FindTextureSlot(std::string tag);
-	// find a defined material by tag
-	bool FindMaterial(std::string tag, OBJECT_MATERIAL& material);
-
-	// set the transformation values 
-	// into the transform buffer
-	void SetTransformations(
-		glm::vec3 scaleXYZ,
-		float XrotationDegrees,
-		float YrotationDegrees,
-		float ZrotationDegrees,
-		glm::vec3 positionXYZ);
-
-	// set the color values into the shader
-	void SetShaderColor(
-		float redColorValue,
-		float greenColorValue,
-		float blueColorValue,
-		float alphaValue);
-
-	// set the texture data into the shader
-	void SetShaderTexture(
-		std::string textureTag);
-
-	// set the UV scale for the texture mapping
-	void SetTextureUVScale(
-		float u, float v);
-
-	// set the object material into the shader
-	void SetShaderMaterial(
-		std::string materialTag);
-
-public:
-
-	// The following methods are for the students to 
-	// customize for their own 3D scene
-	void PrepareScene();
-	void RenderScene();
-
-	// loads textures from image files
-	void LoadSceneTextures();
-
-	// pre-set light sources for 3D scene
-	void SetupSceneLights();
-	// pre-define the object materials for lighting
-	void DefineObjectMaterials();
+///////////////////////////////////////////////////////////////////////////////
+// scenemanager.h
+// ============
+// manage the preparing and rendering of 3D scenes - textures, materials, lighting
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "FrameArena.h"
+#include "ShaderManager.h"
+#include "StreamingBuffer.h"
+#include "ShapeMeshes.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/***********************************************************
+ *  SceneManager
+ *
+ *  This class contains the code for preparing and rendering
+ *  3D scenes, including the shader settings.
+ ***********************************************************/
+class SceneManager
+{
+public:
+	// constructor
+	SceneManager(ShaderManager *pShaderManager);
+	// destructor
+	~SceneManager();
+
+	struct TEXTURE_INFO
+	{
+		std::string tag;
+		uint32_t ID;
+		// accounted GPU bytes held by this texture
+		uint32_t bytes;
+		// source image path, kept so an evicted texture can
+		// be reloaded when it is drawn again
+		std::string filename;
+		// frame number this texture was last drawn on
+		long lastDrawnFrame;
+		// true while the texture is evicted to a placeholder
+		bool bEvicted;
+	};
+
+	struct SCENE_LIGHT
+	{
+		glm::vec3 position;
+		glm::vec3 ambient;
+		glm::vec3 diffuse;
+		glm::vec3 specular;
+	};
+
+	struct OBJECT_MATERIAL
+	{
+		glm::vec3 diffuseColor;
+		glm::vec3 specularColor;
+		float shininess;
+		std::string tag;
+	};
+
+	// the basic mesh shapes that can be referenced by the
+	// retained scene object records
+	enum MESH_ID
+	{
+		MESH_PLANE,
+		MESH_BOX,
+		MESH_SPHERE,
+		MESH_CYLINDER
+	};
+
+	// the authored transform values for one instance within
+	// an instanced scene object cluster
+	struct INSTANCE_TRANSFORM
+	{
+		glm::vec3 scaleXYZ;
+		glm::vec3 rotationDegreesXYZ;
+		glm::vec3 positionXYZ;
+	};
+
+	// a single retained draw record - built once when the scene
+	// is prepared and then replayed every frame by RenderScene()
+	struct SCENE_OBJECT
+	{
+		// the basic mesh shape to draw
+		MESH_ID meshID;
+		// authored transform values - kept so the cached
+		// model matrix can be recomputed when invalidated
+		glm::vec3 scaleXYZ;
+		float XrotationDegrees;
+		float YrotationDegrees;
+		float ZrotationDegrees;
+		glm::vec3 positionXYZ;
+		// cached composed model matrix for the object
+		glm::mat4 modelMatrix;
+		// true when the cached model matrix needs recomputing
+		bool bDirty;
+		// for instanced clusters - the authored per-instance
+		// transforms and the cached per-instance model matrices,
+		// empty for a single-instance object
+		std::vector<INSTANCE_TRANSFORM> instanceTransforms;
+		std::vector<glm::mat4> instanceModels;
+		// shading state resolved at scene-build time - the
+		// tags are kept for tooling, the integer handles are
+		// what the render loop actually uses
+		std::string materialTag;
+		int materialIndex;
+		bool bUseTexture;
+		std::string textureTag;
+		int textureSlot;
+		glm::vec2 uvScale;
+		glm::vec4 color;
+		// packed submission sort key - see MakeSortKey()
+		uint32_t sortKey;
+		// byte offset of this frame's staged instance matrices
+		// inside the streaming buffer, -1 when not staged
+		long instanceStreamOffset;
+	};
+
+private:
+	// pointer to shader manager object
+	ShaderManager* m_pShaderManager;
+	// pointer to basic shapes object
+	ShapeMeshes* m_basicMeshes;
+	// loaded textures info - grows with the scene, textures
+	// are bound on demand so there is no slot ceiling, and
+	// the vector size is the authoritative texture count
+	std::vector<TEXTURE_INFO> m_textureIDs;
+	// defined object materials
+	std::vector<OBJECT_MATERIAL> m_objectMaterials;
+	// a decoded image handed from a loader thread back to the
+	// GL thread for upload
+	struct TEXTURE_LOAD_RESULT
+	{
+		std::string filename;
+		std::string tag;
+		unsigned char* pImage;
+		int width;
+		int height;
+		int colorChannels;
+	};
+
+	// asynchronous texture loading - worker threads run the
+	// image decode while the GL thread only performs uploads
+	std::vector<std::thread> m_textureLoadThreads;
+	std::mutex m_textureLoadMutex;
+	std::queue<TEXTURE_LOAD_RESULT> m_readyTextureLoads;
+	int m_pendingTextureLoads;
+
+	// registration-time registries mapping tags to the integer
+	// handles used by the render loop - the maps are only
+	// touched at scene-build time, never per frame
+	std::unordered_map<std::string, int> m_materialIndices;
+	std::unordered_map<std::string, int> m_textureIndices;
+	// retained list of scene objects built once in PrepareScene()
+	std::vector<SCENE_OBJECT> m_sceneObjects;
+	// submission order of the scene objects, sorted so records
+	// sharing textures/materials/meshes run back-to-back
+	std::vector<int> m_sortedObjectIndices;
+	// the visible subset of the sorted records for the current
+	// frame, produced by the parallel build phase
+	std::vector<int> m_visibleObjectIndices;
+	// the second frame context - the command list built ahead
+	// for the next frame while the GPU consumes the current one
+	std::vector<int> m_nextVisibleObjectIndices;
+	// the persistent pipelined build worker and its
+	// bookkeeping - the worker parks on the condition variable
+	// between frames instead of being recreated every frame
+	std::thread m_frameBuildThread;
+	std::mutex m_frameBuildMutex;
+	std::condition_variable m_frameBuildCondition;
+	bool m_bFrameBuildRequested;
+	bool m_bFrameBuildDone;
+	bool m_bFrameBuildStop;
+	bool m_bFrameBuildPending;
+	// persistent slice-build worker pool - the workers park on
+	// a condition variable between frames, so the parallel
+	// build phase never creates threads on the hot path
+	struct SLICE_JOB
+	{
+		int firstIndex;
+		int lastIndex;
+		int* pVisibleIndices;
+		int* pVisibleCount;
+	};
+	std::vector<std::thread> m_sliceWorkers;
+	std::vector<SLICE_JOB> m_sliceJobs;
+	std::mutex m_sliceMutex;
+	std::condition_variable m_sliceWorkCondition;
+	std::condition_variable m_sliceDoneCondition;
+	int m_sliceJobsTaken;
+	int m_sliceJobsDone;
+	bool m_bSliceWorkersStop;
+	// bumped whenever the supplied camera frustum changes - an
+	// ahead-of-time build is only valid for the version it saw
+	int m_cameraVersion;
+	int m_frameBuildCameraVersion;
+	// the view*projection matrix of the last supplied camera,
+	// used to detect actual camera changes
+	glm::mat4 m_lastViewProjection;
+	// the data-driven point light list - any number of lights
+	// can be registered, the upload pass picks the nearest
+	// ones for the shader's fixed slots each frame
+	std::vector<SCENE_LIGHT> m_pointLights;
+	// slots uploaded on the previous frame and a dirty flag,
+	// so an unchanged selection uploads nothing
+	std::vector<int> m_lastLightSlots;
+	bool m_bLightsDirty;
+	// per-frame light selection scratch - members so the
+	// ranking reuses their capacity instead of allocating
+	std::vector<int> m_lightOrderScratch;
+	std::vector<int> m_selectedLightSlots;
+
+	// per-frame draw order of the transparent records, sorted
+	// back-to-front by camera distance - reused across frames
+	std::vector<int> m_transparentDrawOrder;
+
+	// change journal - indices of the objects mutated since
+	// the last frame build, so the build touches only the
+	// entries that actually changed
+	std::vector<int> m_changeJournal;
+
+	// frame counter driving the least-recently-drawn texture
+	// ranking, and the optional soft texture budget - zero
+	// means no budget is enforced
+	long m_frameNumber;
+	size_t m_textureBudgetBytes;
+
+	// persistently mapped streaming buffer that stages the
+	// per-frame instance matrices in GPU-visible memory, a
+	// flag so a failed creation is only attempted once, and
+	// an enable that is off by default - nothing consumes the
+	// staged matrices until an instanced-attribute draw path
+	// exists, so the staging is opt-in
+	StreamingBuffer m_instanceStreamBuffer;
+	bool m_bInstanceStreamTried;
+	bool m_bInstanceStreamEnabled;
+
+	// bump arena backing the transient per-frame build data -
+	// reset once per frame, so the steady-state hot path
+	// performs no heap allocations
+	FrameArena m_frameArena;
+	// true after the retained scene object list has been built
+	bool m_bSceneBuilt;
+
+	// authoring-time shading state - captured into each scene
+	// object record as it is added to the retained list
+	std::string m_buildMaterialTag;
+	std::string m_buildTextureTag;
+	glm::vec2 m_buildUVScale;
+	glm::vec4 m_buildColor;
+	bool m_bBuildUseTexture;
+
+	// shadowed shader state - used by the render loop to skip
+	// re-uploading uniform values that have not changed since
+	// the previous draw
+	int m_lastMaterialIndex;
+	int m_lastTextureSlot;
+	glm::vec2 m_lastUVScale;
+	glm::vec4 m_lastColor;
+	int m_lastUseTexture;
+	bool m_bLastColorValid;
+	// counters for the shadowed state cache - hits are uniform
+	// uploads that were skipped as redundant
+	long m_uniformCacheHits;
+	long m_uniformCacheMisses;
+
+	// the view frustum planes for the current frame, extracted
+	// from the view*projection matrix in SetFrameCamera()
+	glm::vec4 m_frustumPlanes[6];
+	// true once a frustum has been supplied for culling
+	bool m_bFrustumValid;
+	// snapshot of the frustum taken when a frame build is
+	// launched - the build workers read only the snapshot, so
+	// SetFrameCamera() can update the live planes while an
+	// ahead-of-time build is still running
+	glm::vec4 m_buildFrustumPlanes[6];
+	bool m_bBuildFrustumValid;
+	// the camera position for the current frame
+	glm::vec3 m_cameraPosition;
+	// number of objects culled on the last frame
+	int m_lastCulledCount;
+	// number of draws swapped to a cheaper mesh on the last
+	// frame, and number dropped for sub-pixel coverage
+	int m_lodSubstitutedCount;
+	int m_lodDroppedCount;
+	// mesh drawn by the previous submitted draw, and the
+	// number of mesh switches - each one a VAO/VBO rebind
+	// inside ShapeMeshes - counted over the run
+	int m_lastSubmittedMeshID;
+	long m_meshSwitchCount;
+
+	// load texture images and convert to OpenGL texture data
+	bool CreateGLTexture(const char* filename, const std::string& tag);
+	// load a block-compressed DDS container with its precomputed
+	// mip chain straight into OpenGL texture data
+	bool CreateGLTextureDDS(const char* filename, const std::string& tag);
+	// start an asynchronous texture load - the tag resolves to
+	// a placeholder texture until the decoded image is uploaded
+	bool CreateGLTextureAsync(const char* filename, const std::string& tag);
+	// upload any decoded images that the loader threads have
+	// finished - called once per frame from RenderScene()
+	void PollTextureLoads();
+	// bind loaded OpenGL textures to slots in memory
+	void BindGLTextures();
+	// free the loaded OpenGL textures
+	void DestroyGLTextures();
+	// find a loaded texture by tag
+	int FindTextureID(const std::string& tag);
+	int FindTextureSlot(const std::string& tag);
+	// find a defined material by tag
+	bool FindMaterial(const std::string& tag, OBJECT_MATERIAL& material);
+	// find the integer handle for a defined material by tag,
+	// returns -1 when the tag is not registered
+	int FindMaterialIndex(const std::string& tag);
+
+	// register a defined material and its tag, returns the
+	// integer handle for the registered material
+	int AddObjectMaterial(const OBJECT_MATERIAL& material);
+
+	// set the transformation values 
+	// into the transform buffer
+	void SetTransformations(
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// set the color values into the shader
+	void SetShaderColor(
+		float redColorValue,
+		float greenColorValue,
+		float blueColorValue,
+		float alphaValue);
+
+	// set the texture data into the shader
+	void SetShaderTexture(
+		const std::string& textureTag);
+
+	// set the UV scale for the texture mapping
+	void SetTextureUVScale(
+		float u, float v);
+
+	// set the object material into the shader
+	void SetShaderMaterial(
+		const std::string& materialTag);
+
+	// handle-based hot-path versions of the shader setters -
+	// a direct array index, no string comparisons
+	void SetShaderMaterialByIndex(int materialIndex);
+	void SetShaderTextureBySlot(int textureSlot);
+
+	// build the retained list of scene object draw records
+	void BuildSceneObjects();
+
+	// add a single draw record into the retained scene list,
+	// returns the index of the added record
+	int AddSceneObject(
+		MESH_ID meshID,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// set the authoring-time shading state that is captured
+	// into each scene object record by AddSceneObject()
+	void SetBuildColor(
+		float redColorValue,
+		float greenColorValue,
+		float blueColorValue,
+		float alphaValue);
+	void SetBuildTexture(const std::string& textureTag);
+	void SetBuildUVScale(float u, float v);
+	void SetBuildMaterial(const std::string& materialTag);
+
+	// add a cluster of same-mesh/same-material instances into
+	// the retained scene list as a single draw record, returns
+	// the index of the added record
+	int AddInstancedSceneObjects(
+		MESH_ID meshID,
+		int instanceCount,
+		const INSTANCE_TRANSFORM* pInstanceTransforms);
+
+	// compose the model matrix for a scene object from its
+	// authored transform values
+	void ComposeModelMatrix(SCENE_OBJECT& object);
+
+	// compose a model matrix from individual transform values
+	glm::mat4 ComposeModelMatrix(
+		glm::vec3 scaleXYZ,
+		glm::vec3 rotationDegreesXYZ,
+		glm::vec3 positionXYZ);
+
+	// replay a single retained draw record, issuing one draw
+	// per cached instance matrix with the shading state set
+	// only once for the whole record
+	void SubmitSceneObject(SCENE_OBJECT& object);
+
+	// draw the passed in basic mesh shape
+	void DrawSceneObjectMesh(MESH_ID meshID);
+
+	// pick the mesh to draw for one object or instance based
+	// on its projected screen coverage - far away curved
+	// shapes are swapped for the box mesh, and shapes below
+	// about a pixel of coverage are dropped entirely
+	MESH_ID SelectMeshLOD(
+		MESH_ID meshID,
+		glm::vec3 positionXYZ,
+		float maxScale,
+		bool& bDrawObject);
+
+	// build the packed submission sort key for a scene object
+	uint32_t MakeSortKey(const SCENE_OBJECT& object) const;
+
+	// get the bounding radius of a unit-scaled basic mesh
+	float GetMeshBoundingRadius(MESH_ID meshID) const;
+
+	// test a bounding sphere against the current view frustum
+	bool IsSphereVisible(glm::vec3 center, float radius) const;
+
+	// test a retained scene object - or any instance of a
+	// cluster record - against the current view frustum
+	bool IsObjectVisible(const SCENE_OBJECT& object) const;
+
+	// sort the retained scene objects into submission order
+	void SortSceneObjects();
+
+	// build a visible command list - transform recompute and
+	// frustum tests run on worker threads over disjoint
+	// slices, submission stays serial
+	void BuildFrameCommandList(std::vector<int>& visibleIndices);
+
+	// start building the next frame's command list on a
+	// worker thread, overlapping the GPU work of this frame
+	void StartAsyncFrameBuild();
+
+	// wait for an in-flight pipelined frame build to finish
+	void WaitForFrameBuild();
+
+	// the per-slice work of the frame build - recompose dirty
+	// matrices and cull, writing into the output index list
+	void BuildCommandSlice(
+		int firstIndex,
+		int lastIndex,
+		int* pVisibleIndices,
+		int& visibleCount);
+
+	// the persistent frame-build worker loop
+	void FrameBuildWorkerLoop();
+
+	// copy the live frustum into the build snapshot - called
+	// on the render thread before any frame build starts
+	void SnapshotBuildCamera();
+
+	// start the persistent slice-build workers on first use
+	void StartSliceWorkers();
+	// stop and join the persistent slice-build workers
+	void StopSliceWorkers();
+	// the slice worker loop - claims and runs queued slices
+	void SliceWorkerLoop();
+
+	// evict least-recently-drawn textures while the accounted
+	// texture memory exceeds the soft budget
+	void EnforceTextureBudget();
+
+	// reload an evicted texture's image on a worker thread
+	// after it has been drawn again
+	void ReloadEvictedTexture(int textureSlot);
+
+	// upload the nearest registered point lights into the
+	// shader's fixed light slots - skipped entirely while the
+	// selection is unchanged
+	void UploadSceneLights();
+
+	// apply the journaled object changes at the start of a
+	// frame build - recompute just those cached matrices and
+	// re-sort only when a submission key actually changed
+	void ProcessChangeJournal();
+
+	// append an object to the change journal if it is not
+	// already journaled for this frame
+	void JournalObjectChange(int objectIndex);
+
+public:
+
+	// The following methods are for the students to 
+	// customize for their own 3D scene
+	// decode a texture image ahead of time on a startup
+	// worker thread - CreateGLTextureAsync() adopts the
+	// decoded pixels instead of decoding again
+	static void PrefetchTextureImage(const char* filename);
+
+	void PrepareScene();
+	// build a synthetic scene for the benchmark harness in
+	// place of the authored one - object, material and texture
+	// counts scale the workload
+	void PrepareBenchmarkScene(
+		int objectCount,
+		int materialCount,
+		int textureCount);
+	void RenderScene();
+
+	// loads textures from image files
+	void LoadSceneTextures();
+
+	// pre-set light sources for 3D scene
+	void SetupSceneLights();
+	// pre-define the object materials for lighting
+	void DefineObjectMaterials();
+
+	// update the authored transform values for a retained
+	// scene object - the cached model matrix is recomputed
+	// lazily on the next frame, objects that never move are
+	// never recomposed
+	void SetObjectTransform(
+		int objectIndex,
+		glm::vec3 scaleXYZ,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees,
+		glm::vec3 positionXYZ);
+
+	// flag a retained scene object so its cached model matrix
+	// is recomputed on the next frame
+	void SetObjectTransformDirty(int objectIndex);
+	// journaling mutators for animated objects - move or spin
+	// one retained object without touching the rest of the
+	// scene
+	void SetObjectPosition(int objectIndex, glm::vec3 positionXYZ);
+	void SetObjectRotation(
+		int objectIndex,
+		float XrotationDegrees,
+		float YrotationDegrees,
+		float ZrotationDegrees);
+
+	// get the hit/miss counts of the shadowed uniform state
+	// cache - hits are skipped redundant uploads
+	void GetUniformCacheCounts(long& hits, long& misses) const;
+
+	// set the camera state for the next rendered frame - the
+	// view frustum is extracted here for the culling pass
+	void SetFrameCamera(
+		const glm::mat4& view,
+		const glm::mat4& projection,
+		glm::vec3 cameraPosition);
+
+	// enable staging the per-frame instance matrices into the
+	// streaming buffer - off by default until a draw path
+	// consumes the staged data
+	void SetInstanceStreamingEnabled(bool bEnabled);
+
+	// set the optional soft texture budget in bytes - when
+	// the accounted texture memory exceeds it, the least
+	// recently drawn textures are evicted to placeholders
+	void SetTextureBudgetBytes(size_t budgetBytes);
+
+	// register a point light - no code changes are needed to
+	// add lights, the nearest ones are selected each frame
+	int AddPointLight(const SCENE_LIGHT& light);
+
+	// get the number of objects culled on the last frame
+	int GetLastCulledCount() const;
+
+	// get the number of draws that were swapped to a cheaper
+	// mesh or dropped for sub-pixel coverage on the last frame
+	void GetLODCounts(int& substituted, int& dropped) const;
 };
\ No newline at end of file
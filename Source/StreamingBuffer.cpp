@@ -0,0 +1,213 @@
+///////////////////////////////////////////////////////////////////////////////
+// streamingbuffer.cpp
+// ============
+// persistently mapped GL buffer for streaming per-frame data to the GPU
+///////////////////////////////////////////////////////////////////////////////
+
+#include "StreamingBuffer.h"
+#include "GpuResourceTracker.h"
+
+#include <cstring>
+#include <iostream>
+
+/***********************************************************
+ *  StreamingBuffer()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+StreamingBuffer::StreamingBuffer()
+{
+	m_bufferID = 0;
+	m_target = GL_ARRAY_BUFFER;
+	m_regionBytes = 0;
+	m_pMappedBase = NULL;
+	m_currentRegion = 0;
+	m_regionOffset = 0;
+
+	for (int i = 0; i < REGION_COUNT; i++)
+	{
+		m_regionFences[i] = NULL;
+	}
+}
+
+/***********************************************************
+ *  ~StreamingBuffer()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+StreamingBuffer::~StreamingBuffer()
+{
+	Destroy();
+}
+
+/***********************************************************
+ *  Create()
+ *
+ *  This method is used for creating the persistently mapped
+ *  GL buffer.  The immutable storage is allocated once with
+ *  a coherent write mapping, so the CPU writes are visible
+ *  to the GPU without any flush or unmap calls.
+ ***********************************************************/
+bool StreamingBuffer::Create(GLenum target, size_t regionBytes)
+{
+	GLbitfield storageFlags =
+		GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+	// immutable storage needs GL 4.4 or ARB_buffer_storage -
+	// on an older context the entry point is a null function
+	// pointer, so bail out before touching it
+	if ((0 == GLEW_VERSION_4_4) && (0 == GLEW_ARB_buffer_storage))
+	{
+		std::cout << "INFO: buffer storage not supported - streaming buffer disabled" << std::endl;
+		return(false);
+	}
+
+	m_target = target;
+	m_regionBytes = regionBytes;
+
+	glGenBuffers(1, &m_bufferID);
+	glBindBuffer(m_target, m_bufferID);
+	glBufferStorage(m_target, regionBytes * REGION_COUNT, NULL, storageFlags);
+
+	m_pMappedBase = (unsigned char*)glMapBufferRange(
+		m_target, 0, regionBytes * REGION_COUNT, storageFlags);
+	glBindBuffer(m_target, 0);
+
+	if (NULL == m_pMappedBase)
+	{
+		std::cout << "Could not map streaming buffer" << std::endl;
+		glDeleteBuffers(1, &m_bufferID);
+		m_bufferID = 0;
+		return(false);
+	}
+
+	GpuResourceTracker::Add(
+		GpuResourceTracker::CATEGORY_INSTANCE_BUFFER, regionBytes * REGION_COUNT);
+
+	return(true);
+}
+
+/***********************************************************
+ *  Destroy()
+ *
+ *  This method is used for releasing the GL buffer, its
+ *  persistent mapping and any outstanding fences.
+ ***********************************************************/
+void StreamingBuffer::Destroy()
+{
+	for (int i = 0; i < REGION_COUNT; i++)
+	{
+		if (NULL != m_regionFences[i])
+		{
+			glDeleteSync(m_regionFences[i]);
+			m_regionFences[i] = NULL;
+		}
+	}
+
+	if (NULL != m_pMappedBase)
+	{
+		glBindBuffer(m_target, m_bufferID);
+		glUnmapBuffer(m_target);
+		glBindBuffer(m_target, 0);
+		m_pMappedBase = NULL;
+	}
+
+	if (0 != m_bufferID)
+	{
+		glDeleteBuffers(1, &m_bufferID);
+		GpuResourceTracker::Remove(
+			GpuResourceTracker::CATEGORY_INSTANCE_BUFFER, m_regionBytes * REGION_COUNT);
+		m_bufferID = 0;
+	}
+}
+
+/***********************************************************
+ *  BeginFrame()
+ *
+ *  This method is used for beginning a new frame of writes.
+ *  The fence guarding the region being reused is waited on
+ *  first - with three regions in the ring this only blocks
+ *  when the GPU has fallen two full frames behind.
+ ***********************************************************/
+void StreamingBuffer::BeginFrame()
+{
+	if (NULL != m_regionFences[m_currentRegion])
+	{
+		GLenum waitResult = GL_UNSIGNALED;
+
+		while ((waitResult != GL_ALREADY_SIGNALED) &&
+			(waitResult != GL_CONDITION_SATISFIED))
+		{
+			waitResult = glClientWaitSync(
+				m_regionFences[m_currentRegion],
+				GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+		}
+
+		glDeleteSync(m_regionFences[m_currentRegion]);
+		m_regionFences[m_currentRegion] = NULL;
+	}
+
+	m_regionOffset = 0;
+}
+
+/***********************************************************
+ *  Write()
+ *
+ *  This method is used for copying the passed in data into
+ *  the current frame region - a memcpy straight into the
+ *  GPU-visible mapping.  The returned byte offset from the
+ *  start of the GL buffer is what draw setup binds against.
+ ***********************************************************/
+long StreamingBuffer::Write(const void* pData, size_t bytes)
+{
+	size_t alignedBytes = (bytes + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1);
+	size_t regionBase = (size_t)m_currentRegion * m_regionBytes;
+
+	if ((NULL == m_pMappedBase) ||
+		(m_regionOffset + alignedBytes > m_regionBytes))
+	{
+		return(-1);
+	}
+
+	memcpy(m_pMappedBase + regionBase + m_regionOffset, pData, bytes);
+
+	long offset = (long)(regionBase + m_regionOffset);
+	m_regionOffset += alignedBytes;
+
+	return(offset);
+}
+
+/***********************************************************
+ *  EndFrame()
+ *
+ *  This method is used for fencing the current frame region
+ *  and advancing the ring to the next one.
+ ***********************************************************/
+void StreamingBuffer::EndFrame()
+{
+	m_regionFences[m_currentRegion] =
+		glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	m_currentRegion = (m_currentRegion + 1) % REGION_COUNT;
+}
+
+/***********************************************************
+ *  GetBufferID()
+ *
+ *  This method is used for getting the GL name of the
+ *  underlying buffer.
+ ***********************************************************/
+GLuint StreamingBuffer::GetBufferID() const
+{
+	return(m_bufferID);
+}
+
+/***********************************************************
+ *  IsCreated()
+ *
+ *  This method is used for checking whether the buffer has
+ *  been created.
+ ***********************************************************/
+bool StreamingBuffer::IsCreated() const
+{
+	return(0 != m_bufferID);
+}
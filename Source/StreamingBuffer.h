@@ -0,0 +1,73 @@
+///////////////////////////////////////////////////////////////////////////////
+// streamingbuffer.h
+// ============
+// persistently mapped GL buffer for streaming per-frame data to the GPU
+///////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <GL/glew.h>
+
+#include <cstddef>
+
+/***********************************************************
+ *  StreamingBuffer
+ *
+ *  This class contains the code for a large GL buffer that
+ *  is persistently and coherently mapped, carved into three
+ *  regions reused round-robin with fence-based protection.
+ *  Per-frame data is written straight into GPU-visible
+ *  memory - no glBufferData churn, no driver copies and no
+ *  stalls as long as the GPU stays within a frame or two.
+ ***********************************************************/
+class StreamingBuffer
+{
+public:
+	// constructor
+	StreamingBuffer();
+	// destructor
+	~StreamingBuffer();
+
+	// create the persistently mapped GL buffer - each of the
+	// three regions holds one frame of streamed data
+	bool Create(GLenum target, size_t regionBytes);
+	// release the GL buffer and its mapping
+	void Destroy();
+
+	// begin writing a new frame - waits on the fence guarding
+	// the region being reused, which only blocks when the GPU
+	// has fallen a full ring length behind
+	void BeginFrame();
+	// copy the passed in data into the current frame region -
+	// returns the byte offset from the start of the GL buffer,
+	// or -1 when the region is full
+	long Write(const void* pData, size_t bytes);
+	// fence the current frame region and advance to the next
+	void EndFrame();
+
+	// get the GL name of the underlying buffer
+	GLuint GetBufferID() const;
+	// returns true once the buffer has been created
+	bool IsCreated() const;
+
+private:
+	// number of frame regions in the ring
+	static const int REGION_COUNT = 3;
+	// alignment applied to every write inside a region
+	static const size_t ALIGNMENT = 16;
+
+	// the GL name and bind target of the buffer
+	GLuint m_bufferID;
+	GLenum m_target;
+	// size of one frame region in bytes
+	size_t m_regionBytes;
+	// base of the persistent mapping
+	unsigned char* m_pMappedBase;
+	// region currently being written and the bump offset
+	// inside it
+	int m_currentRegion;
+	size_t m_regionOffset;
+	// one fence per region, signaled when the GPU is done
+	// reading that region's frame
+	GLsync m_regionFences[REGION_COUNT];
+};
@@ -1,276 +1,487 @@
-///////////////////////////////////////////////////////////////////////////////
-// viewmanager.cpp
-// ============
-// manage the viewing of 3D objects within the viewport - camera, projection
-//
-//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
-//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
-///////////////////////////////////////////////////////////////////////////////
-
-#include "ViewManager.h"
-
-// GLM Math Header inclusions
-#include <glm/glm.hpp>
-#include <glm/gtx/transform.hpp>
-#include <glm/gtc/type_ptr.hpp>    
-
-// declaration of the global variables and defines
-namespace
-{
-	// Variables for window width and height
-	const int WINDOW_WIDTH = 1000;
-	const int WINDOW_HEIGHT = 800;
-	const char* g_ViewName = "view";
-	const char* g_ProjectionName = "projection";
-
-	// camera object used for viewing and interacting with
-	// the 3D scene
-	Camera* g_pCamera = nullptr;
-
-	// these variables are used for mouse movement processing
-	float gLastX = WINDOW_WIDTH / 2.0f;
-	float gLastY = WINDOW_HEIGHT / 2.0f;
-	bool gFirstMouse = true;
-
-	// time between current frame and last frame
-	float gDeltaTime = 0.0f; 
-	float gLastFrame = 0.0f;
-
-	// the following variable is false when orthographic projection
-	// is off and true when it is on
-	bool bOrthographicProjection = false;
-}
-
-/***********************************************************
- *  ViewManager()
- *
- *  The constructor for the class
- ***********************************************************/
-ViewManager::ViewManager(
-	ShaderManager *pShaderManager)
-{
-	// initialize the member variables
-	m_pShaderManager = pShaderManager;
-	m_pWindow = NULL;
-	g_pCamera = new Camera();
-	// default camera view parameters
-	g_pCamera->Position = glm::vec3(0.0f, 5.0f, 12.0f);
-	g_pCamera->Front = glm::vec3(0.0f, -0.5f, -2.0f);
-	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
-	g_pCamera->Zoom = 80;
-	g_pCamera->MovementSpeed = 20;
-}
-
-/***********************************************************
- *  ~ViewManager()
- *
- *  The destructor for the class
- ***********************************************************/
-ViewManager::~ViewManager()
-{
-	// free up allocated memory
-	m_pShaderManager = NULL;
-	m_pWindow = NULL;
-	if (NULL != g_pCamera)
-	{
-		delete g_pCamera;
-		g_pCamera = NULL;
-	}
-}
-
-/***********************************************************
- *  CreateDisplayWindow()
- *
- *  This method is used to create the main display window.
- ***********************************************************/
-GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
-{
-	GLFWwindow* window = nullptr;
-
-	// try to create the displayed OpenGL window
-	window = glfwCreateWindow(
-		WINDOW_WIDTH,
-		WINDOW_HEIGHT,
-		windowTitle,
-		NULL, NULL);
-	if (window == NULL)
-	{
-		std::cout << "Failed to create GLFW window" << std::endl;
-		glfwTerminate();
-		return NULL;
-	}
-	glfwMakeContextCurrent(window);
-
-	// tell GLFW to capture all mouse events
-	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
-
-	// this callback is used to receive mouse moving events
-	glfwSetCursorPosCallback(window, &ViewManager::Mouse_Position_Callback);
-
-	//this callback is used to receive mouse scroll events
-	glfwSetScrollCallback(window, &ViewManager::Mouse_Scroll_Callback);
-
-	// enable blending for supporting tranparent rendering
-	glEnable(GL_BLEND);
-	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-	m_pWindow = window;
-
-	return(window);
-}
-
-/***********************************************************
- *  Mouse_Position_Callback()
- *
- *  This method is automatically called from GLFW whenever
- *  the mouse is moved within the active GLFW display window.
- ***********************************************************/
-void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos)
-{
-	// when the first mouse move event is received, this needs to be recorded so that
-	// all subsequent mouse moves can correctly calculate the X position offset and Y
-	// position offset for proper operation
-	if (gFirstMouse)
-	{
-		gLastX = xMousePos;
-		gLastY = yMousePos;
-		gFirstMouse = false;
-	}
-
-	// calculate the X offset and Y offset values for moving the 3D camera accordingly
-	float xOffset = xMousePos - gLastX;
-	float yOffset = gLastY - yMousePos; // reversed since y-coordinates go from bottom to top
-
-	// set the current positions into the last position variables
-	gLastX = xMousePos;
-	gLastY = yMousePos;
-
-	// move the 3D camera according to the calculated offsets
-	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
-}
-
-/***********************************************************
- *  Mouse_Scroll_Callback()
- *
- *  This method is automatically called from GLFW whenever
- *  the mouse wheel is scrolled within the active GLFW display window.
- ***********************************************************/
-void ViewManager::Mouse_Scroll_Callback(GLFWwindow* window, double xoffset, double yoffset)
-{
-	g_pCamera->MovementSpeed += static_cast<float>(yoffset) * 5.0f; // adjusts cam speed 
-	if (g_pCamera->MovementSpeed < 1.0f)
-		g_pCamera->MovementSpeed = 1.0f; // sets minimum cam speed 
-	if (g_pCamera->MovementSpeed > 100.0f)
-		g_pCamera->MovementSpeed = 100.0f; // sets maximum cam speed
-}
-
-/***********************************************************
- *  ProcessKeyboardEvents()
- *
- *  This method is called to process any keyboard events
- *  that may be waiting in the event queue.
- ***********************************************************/
-void ViewManager::ProcessKeyboardEvents()
-{
-	// close the window if the escape key has been pressed
-	if (glfwGetKey(m_pWindow, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-	{
-		glfwSetWindowShouldClose(m_pWindow, true);
-	}
-
-	// process camera zooming in and out
-	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
-	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
-	}
-
-	// process camera panning left and right
-	if (glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(LEFT, gDeltaTime);
-	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(RIGHT, gDeltaTime);
-	}
-
-	// process camera panning up and down
-	if (glfwGetKey(m_pWindow, GLFW_KEY_Q) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(UP, gDeltaTime); 
-	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_E) == GLFW_PRESS)
-	{
-		g_pCamera->ProcessKeyboard(DOWN, gDeltaTime);
-	}
-
-	// process projection toggle
-	if (glfwGetKey(m_pWindow, GLFW_KEY_P) == GLFW_PRESS)
-	{
-		bOrthographicProjection = false;
-	}
-	if (glfwGetKey(m_pWindow, GLFW_KEY_O) == GLFW_PRESS)
-	{
-		bOrthographicProjection = true;
-	}
-}
-
-/***********************************************************
- *  PrepareSceneView()
- *
- *  This method is used for preparing the 3D scene by loading
- *  the shapes, textures in memory to support the 3D scene 
- *  rendering
- ***********************************************************/
-void ViewManager::PrepareSceneView()
-{
-	glm::mat4 view;
-	glm::mat4 projection;
-
-	// per-frame timing
-	float currentFrame = glfwGetTime();
-	gDeltaTime = currentFrame - gLastFrame;
-	gLastFrame = currentFrame;
-
-	// process any keyboard events that may be waiting in the 
-	// event queue
-	ProcessKeyboardEvents();
-
-	// get the current view matrix from the camera
-	view = g_pCamera->GetViewMatrix();
-
-
-	if (bOrthographicProjection)
-	{
-		// Orthographic view looking straight down
-		float aspect = (float)WINDOW_WIDTH / (float)WINDOW_HEIGHT;
-		float scale = 3.0f; 
-		projection = glm::ortho(-scale * aspect, scale * aspect, -scale, scale, 0.1f, 20.0f);
-
-		// reposition camera directly above scene
-		g_pCamera->Position = glm::vec3(0.0f, 5.0f, 0.0f);
-		g_pCamera->Front = glm::vec3(0.0f, -1.0f, 0.0f);
-		g_pCamera->Up = glm::vec3(0.0f, 0.0f, -1.0f); 
-		view = g_pCamera->GetViewMatrix();
-	}
-	else
-	{
-		// define the current projection matrix
-		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)WINDOW_WIDTH / (GLfloat)WINDOW_HEIGHT, 0.1f, 100.0f);
-	}
-
-	// if the shader manager object is valid
-	if (NULL != m_pShaderManager)
-	{
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ViewName, view);
-		// set the view matrix into the shader for proper rendering
-		m_pShaderManager->setMat4Value(g_ProjectionName, projection);
-		// set the view position of the camera into the shader for proper rendering
-		m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
-	}
-}
\ No newline at end of file
+///////////////////////////////////////////////////////////////////////////////
+// viewmanager.cpp
+// ============
+// manage the viewing of 3D objects within the viewport - camera, projection
+//
+//  AUTHOR: Brian Battersby - SNHU Instructor / Computer Science
+//	Created for CS-330-Computational Graphics and Visualization, Nov. 1st, 2023
+///////////////////////////////////////////////////////////////////////////////
+
+#include "ViewManager.h"
+
+// GLM Math Header inclusions
+#include <cmath>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtx/transform.hpp>
+#include <glm/gtc/type_ptr.hpp>    
+
+// declaration of the global variables and defines
+namespace
+{
+	// Variables for window width and height
+	const int WINDOW_WIDTH = 1000;
+	const int WINDOW_HEIGHT = 800;
+	const char* g_ViewName = "view";
+	const char* g_ProjectionName = "projection";
+
+	// camera object used for viewing and interacting with
+	// the 3D scene
+	Camera* g_pCamera = nullptr;
+
+	// these variables are used for mouse movement processing
+	float gLastX = WINDOW_WIDTH / 2.0f;
+	float gLastY = WINDOW_HEIGHT / 2.0f;
+	bool gFirstMouse = true;
+
+	// time between current frame and last frame
+	float gDeltaTime = 0.0f; 
+	float gLastFrame = 0.0f;
+
+	// the following variable is false when orthographic projection
+	// is off and true when it is on
+	bool bOrthographicProjection = false;
+
+	// shadowed copies of the per-frame shader state - the view,
+	// projection and camera position uniforms are only re-sent
+	// when one of these actually changes
+	glm::mat4 gLastViewMatrix;
+	glm::mat4 gLastProjectionMatrix;
+	glm::vec3 gLastViewPosition;
+	bool gFrameStateValid = false;
+
+	// the view/projection state computed by the most recent
+	// PrepareSceneView() call - exposed for the culling and
+	// sorting stages
+	glm::mat4 gCurrentViewMatrix;
+	glm::mat4 gCurrentProjectionMatrix;
+	glm::vec3 gCurrentViewPosition;
+
+	// one fixed camera per registered comparison view - the
+	// retained scene is shared, each view only re-culls and
+	// re-rasterizes it
+	struct VIEW_CAMERA
+	{
+		glm::vec3 position;
+		glm::vec3 target;
+	};
+	std::vector<VIEW_CAMERA> gViewCameras;
+}
+
+/***********************************************************
+ *  ViewManager()
+ *
+ *  The constructor for the class
+ ***********************************************************/
+ViewManager::ViewManager(
+	ShaderManager *pShaderManager)
+{
+	// initialize the member variables
+	m_pShaderManager = pShaderManager;
+	m_pWindow = NULL;
+	g_pCamera = new Camera();
+	// default camera view parameters
+	g_pCamera->Position = glm::vec3(0.0f, 5.0f, 12.0f);
+	g_pCamera->Front = glm::vec3(0.0f, -0.5f, -2.0f);
+	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
+	g_pCamera->Zoom = 80;
+	g_pCamera->MovementSpeed = 20;
+}
+
+/***********************************************************
+ *  ~ViewManager()
+ *
+ *  The destructor for the class
+ ***********************************************************/
+ViewManager::~ViewManager()
+{
+	// free up allocated memory
+	m_pShaderManager = NULL;
+	m_pWindow = NULL;
+	if (NULL != g_pCamera)
+	{
+		delete g_pCamera;
+		g_pCamera = NULL;
+	}
+}
+
+/***********************************************************
+ *  CreateDisplayWindow()
+ *
+ *  This method is used to create the main display window.
+ ***********************************************************/
+GLFWwindow* ViewManager::CreateDisplayWindow(const char* windowTitle)
+{
+	GLFWwindow* window = nullptr;
+
+	// try to create the displayed OpenGL window
+	window = glfwCreateWindow(
+		WINDOW_WIDTH,
+		WINDOW_HEIGHT,
+		windowTitle,
+		NULL, NULL);
+	if (window == NULL)
+	{
+		std::cout << "Failed to create GLFW window" << std::endl;
+		glfwTerminate();
+		return NULL;
+	}
+	glfwMakeContextCurrent(window);
+
+	// tell GLFW to capture all mouse events
+	glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
+
+	// this callback is used to receive mouse moving events
+	glfwSetCursorPosCallback(window, &ViewManager::Mouse_Position_Callback);
+
+	//this callback is used to receive mouse scroll events
+	glfwSetScrollCallback(window, &ViewManager::Mouse_Scroll_Callback);
+
+	// set the blend function for transparent rendering - the
+	// scene manager only enables blending for its transparent
+	// draw phase, so the opaque bulk keeps early-z rejection
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	m_pWindow = window;
+
+	return(window);
+}
+
+/***********************************************************
+ *  Mouse_Position_Callback()
+ *
+ *  This method is automatically called from GLFW whenever
+ *  the mouse is moved within the active GLFW display window.
+ ***********************************************************/
+void ViewManager::Mouse_Position_Callback(GLFWwindow* window, double xMousePos, double yMousePos)
+{
+	// when the first mouse move event is received, this needs to be recorded so that
+	// all subsequent mouse moves can correctly calculate the X position offset and Y
+	// position offset for proper operation
+	if (gFirstMouse)
+	{
+		gLastX = xMousePos;
+		gLastY = yMousePos;
+		gFirstMouse = false;
+	}
+
+	// calculate the X offset and Y offset values for moving the 3D camera accordingly
+	float xOffset = xMousePos - gLastX;
+	float yOffset = gLastY - yMousePos; // reversed since y-coordinates go from bottom to top
+
+	// set the current positions into the last position variables
+	gLastX = xMousePos;
+	gLastY = yMousePos;
+
+	// move the 3D camera according to the calculated offsets
+	g_pCamera->ProcessMouseMovement(xOffset, yOffset);
+}
+
+/***********************************************************
+ *  Mouse_Scroll_Callback()
+ *
+ *  This method is automatically called from GLFW whenever
+ *  the mouse wheel is scrolled within the active GLFW display window.
+ ***********************************************************/
+void ViewManager::Mouse_Scroll_Callback(GLFWwindow* window, double xoffset, double yoffset)
+{
+	g_pCamera->MovementSpeed += static_cast<float>(yoffset) * 5.0f; // adjusts cam speed 
+	if (g_pCamera->MovementSpeed < 1.0f)
+		g_pCamera->MovementSpeed = 1.0f; // sets minimum cam speed 
+	if (g_pCamera->MovementSpeed > 100.0f)
+		g_pCamera->MovementSpeed = 100.0f; // sets maximum cam speed
+}
+
+/***********************************************************
+ *  ProcessKeyboardEvents()
+ *
+ *  This method is called to process any keyboard events
+ *  that may be waiting in the event queue.
+ ***********************************************************/
+void ViewManager::ProcessKeyboardEvents()
+{
+	// close the window if the escape key has been pressed
+	if (glfwGetKey(m_pWindow, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+	{
+		glfwSetWindowShouldClose(m_pWindow, true);
+	}
+
+	// process camera zooming in and out
+	if (glfwGetKey(m_pWindow, GLFW_KEY_W) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(FORWARD, gDeltaTime);
+	}
+	if (glfwGetKey(m_pWindow, GLFW_KEY_S) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(BACKWARD, gDeltaTime);
+	}
+
+	// process camera panning left and right
+	if (glfwGetKey(m_pWindow, GLFW_KEY_A) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(LEFT, gDeltaTime);
+	}
+	if (glfwGetKey(m_pWindow, GLFW_KEY_D) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(RIGHT, gDeltaTime);
+	}
+
+	// process camera panning up and down
+	if (glfwGetKey(m_pWindow, GLFW_KEY_Q) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(UP, gDeltaTime); 
+	}
+	if (glfwGetKey(m_pWindow, GLFW_KEY_E) == GLFW_PRESS)
+	{
+		g_pCamera->ProcessKeyboard(DOWN, gDeltaTime);
+	}
+
+	// process projection toggle
+	if (glfwGetKey(m_pWindow, GLFW_KEY_P) == GLFW_PRESS)
+	{
+		bOrthographicProjection = false;
+	}
+	if (glfwGetKey(m_pWindow, GLFW_KEY_O) == GLFW_PRESS)
+	{
+		bOrthographicProjection = true;
+	}
+}
+
+/***********************************************************
+ *  PrepareSceneView()
+ *
+ *  This method is used for preparing the 3D scene by loading
+ *  the shapes, textures in memory to support the 3D scene 
+ *  rendering
+ ***********************************************************/
+void ViewManager::PrepareSceneView(int viewIndex)
+{
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::vec3 viewPosition;
+	int framebufferWidth = WINDOW_WIDTH;
+	int framebufferHeight = WINDOW_HEIGHT;
+
+	// the framebuffer can be larger than the window coordinates
+	// on high-DPI displays, so the viewports are derived from
+	// its actual dimensions rather than the window constants
+	if (NULL != m_pWindow)
+	{
+		glfwGetFramebufferSize(m_pWindow, &framebufferWidth, &framebufferHeight);
+	}
+
+	// per-frame work runs once, on the first view of the frame
+	if (0 == viewIndex)
+	{
+		// per-frame timing
+		float currentFrame = glfwGetTime();
+		gDeltaTime = currentFrame - gLastFrame;
+		gLastFrame = currentFrame;
+
+		// process any keyboard events that may be waiting in the 
+		// event queue
+		ProcessKeyboardEvents();
+	}
+
+	// a registered comparison view renders with its own fixed
+	// camera into its own viewport region of the window
+	if (gViewCameras.size() > 0)
+	{
+		const VIEW_CAMERA& viewCamera = gViewCameras[viewIndex];
+		int columns = (gViewCameras.size() > 2) ? 2 : (int)gViewCameras.size();
+		int rows = ((int)gViewCameras.size() + columns - 1) / columns;
+		int viewWidth = framebufferWidth / columns;
+		int viewHeight = framebufferHeight / rows;
+		int column = viewIndex % columns;
+		int row = (rows - 1) - (viewIndex / columns);
+
+		glViewport(column * viewWidth, row * viewHeight, viewWidth, viewHeight);
+
+		view = glm::lookAt(viewCamera.position, viewCamera.target,
+			glm::vec3(0.0f, 1.0f, 0.0f));
+		viewPosition = viewCamera.position;
+		projection = glm::perspective(glm::radians(80.0f),
+			(GLfloat)viewWidth / (GLfloat)viewHeight, 0.1f, 100.0f);
+
+		gCurrentViewMatrix = view;
+		gCurrentProjectionMatrix = projection;
+		gCurrentViewPosition = viewPosition;
+
+		if (NULL != m_pShaderManager)
+		{
+			// every view has its own camera, so the per-frame
+			// values are always re-sent here
+			m_pShaderManager->setMat4Value(g_ViewName, view);
+			m_pShaderManager->setMat4Value(g_ProjectionName, projection);
+			m_pShaderManager->setVec3Value("viewPosition", viewPosition);
+			gLastViewMatrix = view;
+			gLastProjectionMatrix = projection;
+			gLastViewPosition = viewPosition;
+			gFrameStateValid = true;
+		}
+
+		return;
+	}
+
+	glViewport(0, 0, framebufferWidth, framebufferHeight);
+
+	// get the current view matrix from the camera
+	view = g_pCamera->GetViewMatrix();
+
+
+	if (bOrthographicProjection)
+	{
+		// Orthographic view looking straight down
+		float aspect = (float)framebufferWidth / (float)framebufferHeight;
+		float scale = 3.0f; 
+		projection = glm::ortho(-scale * aspect, scale * aspect, -scale, scale, 0.1f, 20.0f);
+
+		// reposition camera directly above scene
+		g_pCamera->Position = glm::vec3(0.0f, 5.0f, 0.0f);
+		g_pCamera->Front = glm::vec3(0.0f, -1.0f, 0.0f);
+		g_pCamera->Up = glm::vec3(0.0f, 0.0f, -1.0f); 
+		view = g_pCamera->GetViewMatrix();
+	}
+	else
+	{
+		// define the current projection matrix
+		projection = glm::perspective(glm::radians(g_pCamera->Zoom), (GLfloat)framebufferWidth / (GLfloat)framebufferHeight, 0.1f, 100.0f);
+	}
+
+	// keep the computed per-frame state available for the
+	// culling and sorting stages
+	gCurrentViewMatrix = view;
+	gCurrentProjectionMatrix = projection;
+	gCurrentViewPosition = g_pCamera->Position;
+
+	// if the shader manager object is valid
+	if (NULL != m_pShaderManager)
+	{
+		// only re-send the per-frame values that have changed
+		// since the previous frame - with a static camera this
+		// uploads nothing at all
+		if ((false == gFrameStateValid) || (view != gLastViewMatrix))
+		{
+			// set the view matrix into the shader for proper rendering
+			m_pShaderManager->setMat4Value(g_ViewName, view);
+			gLastViewMatrix = view;
+		}
+		if ((false == gFrameStateValid) || (projection != gLastProjectionMatrix))
+		{
+			// set the projection matrix into the shader for proper rendering
+			m_pShaderManager->setMat4Value(g_ProjectionName, projection);
+			gLastProjectionMatrix = projection;
+		}
+		if ((false == gFrameStateValid) || (g_pCamera->Position != gLastViewPosition))
+		{
+			// set the view position of the camera into the shader for proper rendering
+			m_pShaderManager->setVec3Value("viewPosition", g_pCamera->Position);
+			gLastViewPosition = g_pCamera->Position;
+		}
+		gFrameStateValid = true;
+	}
+}
+
+/***********************************************************
+ *  GetViewMatrix()
+ *
+ *  This method is used for getting the view matrix computed
+ *  by the most recent PrepareSceneView() call.
+ ***********************************************************/
+glm::mat4 ViewManager::GetViewMatrix() const
+{
+	return(gCurrentViewMatrix);
+}
+
+/***********************************************************
+ *  GetProjectionMatrix()
+ *
+ *  This method is used for getting the projection matrix
+ *  computed by the most recent PrepareSceneView() call.
+ ***********************************************************/
+glm::mat4 ViewManager::GetProjectionMatrix() const
+{
+	return(gCurrentProjectionMatrix);
+}
+
+/***********************************************************
+ *  SetOrbitCamera()
+ *
+ *  This method is used for placing the camera on a circular
+ *  orbit around the scene center.  The benchmark harness
+ *  calls this every frame with an advancing angle so every
+ *  run sees the identical camera path.
+ ***********************************************************/
+void ViewManager::SetOrbitCamera(float angleDegrees, float radius, float height)
+{
+	if (NULL == g_pCamera)
+	{
+		return;
+	}
+
+	float angleRadians = glm::radians(angleDegrees);
+
+	g_pCamera->Position = glm::vec3(
+		radius * cosf(angleRadians),
+		height,
+		radius * sinf(angleRadians));
+	g_pCamera->Front = glm::normalize(glm::vec3(0.0f, 1.0f, 0.0f) - g_pCamera->Position);
+	g_pCamera->Up = glm::vec3(0.0f, 1.0f, 0.0f);
+}
+
+/***********************************************************
+ *  GetCameraPosition()
+ *
+ *  This method is used for getting the current position of
+ *  the scene camera.
+ ***********************************************************/
+glm::vec3 ViewManager::GetCameraPosition() const
+{
+	if (gViewCameras.size() > 0)
+	{
+		return(gCurrentViewPosition);
+	}
+	if (NULL != g_pCamera)
+	{
+		return(g_pCamera->Position);
+	}
+
+	return(glm::vec3(0.0f));
+}
+
+/***********************************************************
+ *  AddViewCamera()
+ *
+ *  This method is used for registering an extra fixed camera
+ *  for the comparison wall - the shared retained scene is
+ *  rendered once per registered view, so the scene memory is
+ *  paid once no matter how many views show it.
+ ***********************************************************/
+int ViewManager::AddViewCamera(glm::vec3 position, glm::vec3 target)
+{
+	VIEW_CAMERA viewCamera;
+
+	viewCamera.position = position;
+	viewCamera.target = target;
+	gViewCameras.push_back(viewCamera);
+
+	return((int)gViewCameras.size() - 1);
+}
+
+/***********************************************************
+ *  GetViewCount()
+ *
+ *  This method is used for getting the number of views the
+ *  frame loop renders - one when no extra cameras have been
+ *  registered.
+ ***********************************************************/
+int ViewManager::GetViewCount() const
+{
+	if (gViewCameras.size() > 0)
+	{
+		return((int)gViewCameras.size());
+	}
+
+	return(1);
+}